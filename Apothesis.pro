@@ -6,7 +6,8 @@ TEMPLATE = app
 TARGET = apothesis
 
 QT-=gui core
-QMAKE_CXXFLAGS += -std=c++17
+QMAKE_CXXFLAGS += -std=c++17 -fopenmp
+LIBS += -fopenmp -pthread
 CONFIG += debug_and_release
 CONFING -= qt
 
@@ -15,16 +16,20 @@ INCLUDEPATH += . \
          ./src/lattice \
          ./src/processes \
          ./src/IO \
-#         ./src/species \
+         ./src/engine \
+         ./src/species \
          ./src/error
 
 # Input
 HEADERS += ./src/apothesis.h \
+           ./src/ensemble.h \
+           ./src/sweep.h \
            ./src/IO/io.h \
            ./src/IO/cml_reader.h \
            ./src/IO/reader.h \
            ./src/IO/xyz_reader.h \
            ./src/lattice/SimpleCubic.h \
+           ./src/lattice/CoarseGrained.h \
            ./src/processes/adsorption.h \
            ./src/extLibs/random_generator.h \
            ./src/extLibs/randomc.h \
@@ -36,16 +41,32 @@ HEADERS += ./src/apothesis.h \
            ./src/lattice/FCC.h \
            ./src/lattice/lattice.h \
            ./src/lattice/site.h \
+           ./src/lattice/site_storage.h \
+           ./src/lattice/neighbour_table.h \
+           ./src/lattice/stencil.h \
            ./src/processes/abstract_process.h \
            ./src/processes/desorption.h \
            ./src/processes/diffusion.h \
            ./src/processes/factory_process.h \
            ./src/processes/io.h \
            ./src/processes/parameters.h \
-           ./src/processes/process.h
-#           ./src/ species/species.h
+           ./src/processes/process.h \
+           ./src/engine/selector.h \
+           ./src/engine/linear_selector.h \
+           ./src/engine/tree_selector.h \
+           ./src/engine/composition_rejection_selector.h \
+           ./src/engine/next_reaction_scheduler.h \
+           ./src/engine/synchronous_sublattice.h \
+           ./src/engine/site_class.h \
+           ./src/engine/bond_class.h \
+           ./src/engine/checkpoint.h \
+           ./src/engine/rate_scaling.h \
+           ./src/species/species.h \
+           ./src/species/species_registry.h
 
 SOURCES += ./src/apothesis.cpp \
+           ./src/ensemble.cpp \
+           ./src/sweep.cpp \
            ./src/IO/io.cpp \
            ./src/IO/cml_reader.cpp \
            ./src/IO/reader.cpp \
@@ -53,6 +74,7 @@ SOURCES += ./src/apothesis.cpp \
            ./src/extLibs/mersenne.cpp \
            ./src/extLibs/random_generator.cpp \
            ./src/lattice/SimpleCubic.cpp \
+           ./src/lattice/CoarseGrained.cpp \
            ./src/lattice/lattice.cpp \
            ./src/main.cpp \
            ./src/processes/abstract_process.cpp \
@@ -61,10 +83,23 @@ SOURCES += ./src/apothesis.cpp \
            ./src/error/errorhandler.cpp \
            ./src/lattice/FCC.cpp \
            ./src/lattice/site.cpp \
+           ./src/lattice/site_storage.cpp \
+           ./src/lattice/neighbour_table.cpp \
            ./src/processes/adsorption.cpp \
            ./src/processes/desorption.cpp \
            ./src/processes/diffusion.cpp \
            ./src/processes/factory_process.cpp \
            ./src/processes/parameters.cpp \
-           ./src/processes/process.cpp
-#           ./src/species/species.cpp
+           ./src/processes/process.cpp \
+           ./src/engine/selector.cpp \
+           ./src/engine/linear_selector.cpp \
+           ./src/engine/tree_selector.cpp \
+           ./src/engine/composition_rejection_selector.cpp \
+           ./src/engine/next_reaction_scheduler.cpp \
+           ./src/engine/synchronous_sublattice.cpp \
+           ./src/engine/site_class.cpp \
+           ./src/engine/bond_class.cpp \
+           ./src/engine/checkpoint.cpp \
+           ./src/engine/rate_scaling.cpp \
+           ./src/species/species.cpp \
+           ./src/species/species_registry.cpp
@@ -16,6 +16,9 @@
 //============================================================================
 
 #include "io.h"
+#include "CoarseGrained.h"
+
+#include <filesystem>
 
 IO::IO(Apothesis* apothesis):Pointers(apothesis),
     m_sLatticeType("NONE"),
@@ -31,12 +34,24 @@ IO::IO(Apothesis* apothesis):Pointers(apothesis),
     m_sGrowth("growth"),
     m_sCommentLine("#"),
     m_sPrecursors("precursors"),
-    m_sReport("report")
+    m_sReport("report"),
+    m_sSelection("selection"),
+    m_sDebug("debug"),
+    m_sScheduler("scheduler"),
+    m_sParallel("parallel"),
+    m_sEnsemble("ensemble"),
+    m_sSweep("sweep"),
+    m_sThreads("threads"),
+    m_sCheckpoint("checkpoint"),
+    m_sRestart("restart"),
+    m_sOrdering("ordering"),
+    m_sAcceleration("acceleration")
 {
     //Initialize the map for the lattice
     m_mLatticeType[ "NONE" ] = Lattice::NONE;
     m_mLatticeType[ "SimpleCubic" ] = Lattice::SimpleCubic;
     m_mLatticeType[ "FCC" ] = Lattice::FCC;
+    m_mLatticeType[ "CoarseGrained" ] = Lattice::CoarseGrained;
 }
 
 IO::~IO(){}
@@ -49,10 +64,29 @@ void IO::init(int argc, char* argv[])
 
 string IO::getInputPath() const {;}
 
+const string& IO::getOutputPath() const { return m_sOutputPath; }
+
+void IO::setOutputPath( string path )
+{
+    m_sOutputPath = path;
+    if ( m_sOutputPath.empty() )
+        return;
+
+    if ( m_sOutputPath.back() != BAC )
+        m_sOutputPath += BAC;
+
+    error_code error;
+    filesystem::create_directories( m_sOutputPath, error );
+    if ( error ){
+        m_errorHandler->error_simple_msg( "Cannot create the output directory " + m_sOutputPath );
+        EXIT
+    }
+}
+
 
 void IO::readInputFile()
 {
-    list< string > lKeywords{ m_sLattice, m_sPressure, m_sTemperature, m_sTime, m_sSteps, m_sRandom, m_sSpecies, m_sWrite, m_sGrowth, m_sReport};
+    list< string > lKeywords{ m_sLattice, m_sPressure, m_sTemperature, m_sTime, m_sSteps, m_sRandom, m_sSpecies, m_sWrite, m_sGrowth, m_sReport, m_sSelection, m_sDebug, m_sScheduler, m_sParallel, m_sEnsemble, m_sSweep, m_sThreads, m_sCheckpoint, m_sRestart, m_sOrdering, m_sAcceleration};
 
     string sLine;
     while ( getline( m_InputFile, sLine ) ) {
@@ -115,6 +149,24 @@ void IO::readInputFile()
 
             m_lattice->setType( vsTokens[ 0 ] );
 
+            //The coarse-grained lattice replaces the simple cubic one (every class sharing the lattice points to it through apothesis)
+            //and takes the edge of its cells after the species of the lattice
+            if ( m_lattice->getType() == Lattice::CoarseGrained ){
+                if ( vsTokens.size() < 6 || !isNumber( vsTokens[ 5 ] ) || toInt( trim( vsTokens[ 5 ] ) ) < 1 ){
+                    m_errorHandler->error_simple_msg("The coarse-grained lattice needs the edge of its cells (in sites) after the species of the lattice.");
+                    EXIT
+                }
+
+                CoarseGrained* cells = new CoarseGrained( m_apothesis );
+                cells->setCellEdge( toInt( trim( vsTokens[ 5 ] ) ) );
+                cells->setOrdering( m_lattice->getOrdering() );
+                cells->setSteps( m_lattice->hasSteps() );
+
+                delete m_lattice;
+                m_lattice = cells;
+                m_lattice->setType( vsTokens[ 0 ] );
+            }
+
             if ( isNumber( vsTokens[ 1 ] ) ){
                 m_lattice->setX( toInt(  trim( vsTokens[ 1 ] ) ) );
             }
@@ -376,6 +428,13 @@ void IO::readInputFile()
             }
             m_parameters->setProcess( vsTokensBasic[ 0 ], tempVec );
 
+            //The species of the process get their IDs in the order they are read
+            for ( string react:getReactants( vsTokensBasic[ 0 ] ) )
+                m_parameters->getSpeciesRegistry().add( analyzeCompound( react ).first );
+
+            for ( string prod:getProducts( vsTokensBasic[ 0 ] ) )
+                m_parameters->getSpeciesRegistry().add( analyzeCompound( prod ).first );
+
             continue;
         }
 
@@ -394,7 +453,235 @@ void IO::readInputFile()
             m_parameters->setCoverageSpecies( species);
         }
 
+        if ( vsTokensBasic[ 0 ].compare( m_sDebug ) == 0 ){
+            string debug = trim( vsTokensBasic[ 1 ] );
+
+            if ( startsWith( debug, "on" ) )
+                m_apothesis->setDebugMode( true );
+            else if ( startsWith( debug, "off" ) )
+                m_apothesis->setDebugMode( false );
+            else {
+                m_errorHandler->error_simple_msg("Could not read debug mode. Available selections are: \"on\" and \"off\"");
+                EXIT
+            }
+
+            continue;
+        }
+
+        if ( vsTokensBasic[ 0 ].compare( m_sOrdering ) == 0 ){
+            string ordering = trim( vsTokensBasic[ 1 ] );
+
+            if ( startsWith( ordering, "row-major" ) )
+                m_lattice->setOrdering( Lattice::ROW_MAJOR );
+            else if ( startsWith( ordering, "morton" ) )
+                m_lattice->setOrdering( Lattice::MORTON );
+            else {
+                m_errorHandler->error_simple_msg("Not correct keyword for ordering. Available orderings are: \"row-major\" and \"morton\"");
+                EXIT
+            }
+
+            continue;
+        }
+
+        if ( vsTokensBasic[ 0 ].compare( m_sSelection ) == 0 ){
+            vector<string> vsTokens;
+            vsTokens = split( vsTokensBasic[ 1 ], string( " " ) );
+
+            bool bComment = false;
+            for ( unsigned int i = 0; i< vsTokens.size(); i++){
+                if ( !bComment && startsWith( vsTokens[ i ], m_sCommentLine ) )
+                    bComment = true;
+
+                // Remove the comments from the tokens so not to consider them
+                if ( bComment )
+                    vsTokens[ i ].clear();
+            }
+
+            // Remove any empty parts of the vector
+            vector<string>::iterator it = remove_if( vsTokens.begin(), vsTokens.end(), mem_fun_ref(&string::empty) );
+            vsTokens.erase( it, vsTokens.end() );
+
+            string selection = vsTokens.size() > 0 ? vsTokens[ 0 ] : "";
+
+            if ( selection.compare("linear") == 0 || selection.compare("tree") == 0 || selection.compare("composition") == 0 )
+                m_parameters->setSelection( selection );
+            else {
+                m_errorHandler->error_simple_msg("Not correct keyword for selection. Available selections are: \"linear\", \"tree\" and \"composition\"");
+                EXIT
+            }
+
+            continue;
+        }
+
+        if ( vsTokensBasic[ 0 ].compare( m_sScheduler ) == 0 ){
+            vector<string> vsTokens;
+            vsTokens = split( vsTokensBasic[ 1 ], string( " " ) );
+
+            string scheduler = vsTokens.size() > 0 ? vsTokens[ 0 ] : "";
+
+            if ( scheduler.compare("direct") == 0 || scheduler.compare("nrm") == 0 )
+                m_parameters->setScheduler( scheduler );
+            else {
+                m_errorHandler->error_simple_msg("Not correct keyword for scheduler. Available schedulers are: \"direct\" and \"nrm\"");
+                EXIT
+            }
+
+            continue;
+        }
+
+        if ( vsTokensBasic[ 0 ].compare( m_sParallel ) == 0 ){
+            vector<string> vsTokens;
+            vsTokens = split( vsTokensBasic[ 1 ], string( " " ) );
+
+            if ( vsTokens.size() < 2 || !isNumber( vsTokens[ 0 ] ) || !isNumber( vsTokens[ 1 ] ) || toInt( vsTokens[ 0 ] ) < 1 || toDouble( vsTokens[ 1 ] ) <= 0.0 ){
+                m_errorHandler->error_simple_msg("Could not read the parallel run. It must be given as \"parallel: <number of domains> <time window>\"");
+                EXIT
+            }
+
+            m_parameters->setParallelDomains( toInt( vsTokens[ 0 ] ) );
+            m_parameters->setParallelWindow( toDouble( vsTokens[ 1 ] ) );
+
+            continue;
+        }
+
+        if ( vsTokensBasic[ 0 ].compare( m_sAcceleration ) == 0 ){
+            vector<string> vsTokens;
+            vsTokens = split( vsTokensBasic[ 1 ], string( " " ) );
+            vector<string>::iterator it = remove_if( vsTokens.begin(), vsTokens.end(), mem_fun_ref(&string::empty) );
+            vsTokens.erase( it, vsTokens.end() );
+
+            if ( vsTokens.size() < 3 || vsTokens.size() > 4 || !isNumber( vsTokens[ 0 ] ) || !isNumber( vsTokens[ 1 ] ) || !isNumber( vsTokens[ 2 ] ) ||
+                 toInt( vsTokens[ 0 ] ) < 1 || toDouble( vsTokens[ 1 ] ) < 0.0 || toDouble( vsTokens[ 2 ] ) < 1.0 ||
+                 ( vsTokens.size() == 4 && ( !isNumber( vsTokens[ 3 ] ) || toInt( vsTokens[ 3 ] ) < 1 || toInt( vsTokens[ 3 ] ) > toInt( vsTokens[ 0 ] ) ) ) ){
+                m_errorHandler->error_simple_msg("Could not read the acceleration. It must be given as \"acceleration: <events of a stage> <tolerance> <fast ratio> [<minimum executions>]\" with the minimum executions at most the events of a stage");
+                EXIT
+            }
+
+            m_parameters->setAccelerationStage( toInt( vsTokens[ 0 ] ) );
+            m_parameters->setAccelerationTolerance( toDouble( vsTokens[ 1 ] ) );
+            m_parameters->setAccelerationFast( toDouble( vsTokens[ 2 ] ) );
+            if ( vsTokens.size() == 4 )
+                m_parameters->setAccelerationMinimum( toInt( vsTokens[ 3 ] ) );
+
+            continue;
+        }
+
+        if ( vsTokensBasic[ 0 ].compare( m_sEnsemble ) == 0 ){
+            vector<string> vsTokens;
+            vsTokens = split( vsTokensBasic[ 1 ], string( " " ) );
+
+            if ( vsTokens.empty() || !isNumber( vsTokens[ 0 ] ) || toInt( vsTokens[ 0 ] ) < 1 ||
+                 ( vsTokens.size() > 1 && ( !isNumber( vsTokens[ 1 ] ) || toInt( vsTokens[ 1 ] ) < 1 ) ) ){
+                m_errorHandler->error_simple_msg("Could not read the ensemble. It must be given as \"ensemble: <number of runs> [number of threads]\"");
+                EXIT
+            }
+
+            m_parameters->setEnsembleRuns( toInt( vsTokens[ 0 ] ) );
+            if ( vsTokens.size() > 1 )
+                m_parameters->setThreads( toInt( vsTokens[ 1 ] ) );
+
+            continue;
+        }
+
+        if ( vsTokensBasic[ 0 ].compare( m_sThreads ) == 0 ){
+            string threads = trim( vsTokensBasic[ 1 ] );
+
+            if ( !isNumber( threads ) || toInt( threads ) < 1 ){
+                m_errorHandler->error_simple_msg("Could not read the number of threads. Is it a positive number?");
+                EXIT
+            }
+
+            m_parameters->setThreads( toInt( threads ) );
+
+            continue;
+        }
+
+        if ( vsTokensBasic[ 0 ].compare( m_sCheckpoint ) == 0 ){
+            //"checkpoint: [time <simulated time>] [wall <wall clock time>]". Without intervals they are written only when signaled.
+            vector<string> vsTokens = vsTokensBasic.size() > 1 ? split( vsTokensBasic[ 1 ], string( " " ) ) : vector<string>();
+            vector<string>::iterator it = remove_if( vsTokens.begin(), vsTokens.end(), mem_fun_ref(&string::empty) );
+            vsTokens.erase( it, vsTokens.end() );
+
+            for ( unsigned int i = 0; i < vsTokens.size(); i += 2 ){
+                if ( i + 1 >= vsTokens.size() || !isNumber( vsTokens[ i + 1 ] ) || toDouble( vsTokens[ i + 1 ] ) <= 0.0 ||
+                     ( vsTokens[ i ].compare( "time" ) != 0 && vsTokens[ i ].compare( "wall" ) != 0 ) ){
+                    m_errorHandler->error_simple_msg("Could not read the checkpoint. It must be given as \"checkpoint: [time <simulated time>] [wall <wall clock time>]\"");
+                    EXIT
+                }
+
+                if ( vsTokens[ i ].compare( "time" ) == 0 )
+                    m_parameters->setCheckpointTime( toDouble( vsTokens[ i + 1 ] ) );
+                else
+                    m_parameters->setCheckpointWallTime( toDouble( vsTokens[ i + 1 ] ) );
+            }
+
+            m_parameters->setCheckpoint( true );
+
+            continue;
+        }
+
+        if ( vsTokensBasic[ 0 ].compare( m_sRestart ) == 0 ){
+            string file = vsTokensBasic.size() > 1 ? trim( vsTokensBasic[ 1 ] ) : "";
+
+            if ( file.empty() ){
+                m_errorHandler->error_simple_msg("Could not read the restart. It must be given as \"restart: <checkpoint file>\"");
+                EXIT
+            }
+
+            m_parameters->setRestartFile( file );
+
+            continue;
+        }
+
+        if ( vsTokensBasic[ 0 ].compare( m_sSweep ) == 0 ){
+            //Either "sweep: temperature|pressure <values>" or "sweep: <process>: <position of the parameter> <values>"
+            bool bProcess = vsTokensBasic.size() > 2;
+            string name = bProcess ? trim( vsTokensBasic[ 1 ] ) : "";
+
+            vector<string> vsTokens = split( vsTokensBasic[ bProcess ? 2 : 1 ], string( " " ) );
+            vector<string>::iterator it = remove_if( vsTokens.begin(), vsTokens.end(), mem_fun_ref(&string::empty) );
+            vsTokens.erase( it, vsTokens.end() );
+
+            if ( !bProcess && !vsTokens.empty() ){
+                name = vsTokens[ 0 ];
+                vsTokens[ 0 ] = "0";
+            }
+
+            if ( ( !bProcess && name.compare( m_sTemperature ) != 0 && name.compare( m_sPressure ) != 0 ) || vsTokens.size() < 2 ){
+                m_errorHandler->error_simple_msg("Could not read the sweep. It must be given as \"sweep: temperature|pressure <values>\" or \"sweep: <process>: <position of the parameter> <values>\"");
+                EXIT
+            }
+
+            for ( string token:vsTokens ){
+                if ( !isNumber( token ) ){
+                    m_errorHandler->error_simple_msg("Could not read the sweep of " + name + ". The values must be numbers.");
+                    EXIT
+                }
+            }
+
+            m_parameters->addSweep( name, toInt( vsTokens[ 0 ] ), vector<string>( vsTokens.begin() + 1, vsTokens.end() ) );
+
+            continue;
+        }
+
     }//Reading the lines
+
+    //The swept parameters of the processes must exist (the processes may be given after the sweep)
+    for ( const SweptParameter& sweep:m_parameters->getSweeps() ){
+        if ( sweep.iPosition == 0 )
+            continue;
+
+        map< string, vector<string> > processes = m_parameters->getProcessesInfo();
+        if ( processes.find( sweep.sName ) == processes.end() ){
+            m_errorHandler->error_simple_msg("The swept process " + sweep.sName + " is not given in the input file.");
+            EXIT
+        }
+
+        if ( sweep.iPosition < 1 || sweep.iPosition >= (int)processes[ sweep.sName ].size() ){
+            m_errorHandler->error_simple_msg("The swept process " + sweep.sName + " does not have a parameter in position " + to_string( sweep.iPosition ) + ".");
+            EXIT
+        }
+    }
 }
 
 void IO::openInputFile( string file )
@@ -409,7 +696,7 @@ void IO::openInputFile( string file )
 
 void IO::openRoughnessFile( string file )
 {
-    m_RoughnessFile.open(file, ios::out );
+    m_RoughnessFile.open( m_sOutputPath + file, ios::out );
 
     if ( !m_RoughnessFile.is_open() ) {
         m_errorHandler->error_simple_msg( "Cannot open file " + file ) ;
@@ -628,16 +915,41 @@ bool IO::contains(string str1, string str2, CASE cas )
 /// Opens the output file
 bool IO::openOutputFile( string name )
 {
-    m_OutFile.open( name + ".log" , ios::out );
+    m_OutFile.open( m_sOutputPath + name + ".log" , ios::out );
     if ( m_OutFile.is_open() )
         return true;
 
     m_errorHandler->error_simple_msg( "Cannot open file log for writting." ) ;
-    exit(-1);
+    EXIT
     //    return false;
 }
 
 
+void IO::resumeOutputFile( string name, long size )
+{
+    string file = m_sOutputPath + name + ".log";
+
+    error_code error;
+    if ( (long)filesystem::file_size( file, error ) < size || error ){
+        m_errorHandler->error_simple_msg( "The output file " + file + " is missing or shorter than at the checkpoint." ) ;
+        EXIT
+    }
+
+    filesystem::resize_file( file, size, error );
+
+    m_OutFile.open( file, ios::out | ios::app );
+    if ( error || !m_OutFile.is_open() ){
+        m_errorHandler->error_simple_msg( "Cannot open file log for writting." ) ;
+        EXIT
+    }
+}
+
+long IO::getOutputSize()
+{
+    m_OutFile.flush();
+    return m_OutFile.tellp();
+}
+
 void IO::writeInOutput( string toWrite )
 {
     m_OutFile << toWrite << endl;
@@ -675,14 +987,20 @@ void IO::writeLatticeHeights( double time  )
     streamObj.precision(15);
     streamObj << time;
 
-    std::string name="Height_" + streamObj.str() + ".dat";
+    std::string name=m_sOutputPath + "Height_" + streamObj.str() + ".dat";
     std::ofstream file(name);
 
     file << "Time (s): " << time << endl;
 
+    //The cells of a coarse-grained lattice are written with the mean height of their sites
+    int iSitesPerCell = m_lattice->getSitesPerCell();
     for (int i = 0; i < m_lattice->getY(); i++){
-        for (int j = 0; j < m_lattice->getX(); j++)
-            file << m_lattice->getSite( i*m_lattice->getX() + j )->getHeight() << " " ;
+        for (int j = 0; j < m_lattice->getX(); j++){
+            if ( iSitesPerCell == 1 )
+                file << m_lattice->getSite( i, j )->getHeight() << " " ;
+            else
+                file << (double)m_lattice->getSite( i, j )->getHeight()/iSitesPerCell << " " ;
+        }
 
         file << endl;
     }
@@ -697,14 +1015,14 @@ void IO::writeLatticeSpecies( double time  )
     streamObj.precision(15);
     streamObj << time;
 
-    std::string name="SurfaceSpecies_" + streamObj.str() + ".dat";
+    std::string name=m_sOutputPath + "SurfaceSpecies_" + streamObj.str() + ".dat";
     std::ofstream file(name);
     file << "Time (s): " << time << endl;
     file.precision(10);
 
     for (int i = 0; i < m_lattice->getY(); i++){
         for (int j = 0; j < m_lattice->getX(); j++)
-            file << m_lattice->getSite( i*m_lattice->getX() + j )->getLabel() << " " ;
+            file << m_lattice->getSite( i, j )->getLabel() << " " ;
 
         file << endl;
     }
@@ -75,9 +75,12 @@ class IO: public Pointers
     /// Returns the path of the input file.
     string getInputPath() const;
 
-    /// Returns the path of the output file.
+    /// Returns the path of the output files (empty for the working directory).
     const string& getOutputPath() const;
 
+    /// Sets the path where the output files of this instance are written. The directory is created if it does not exist.
+    void setOutputPath( string path );
+
     /// Returns the name of the input file if it is user defined.
     const string& getInputFilename() const;
 
@@ -95,6 +98,13 @@ class IO: public Pointers
     /// Write in the output file.
     void writeInOutput( string );
 
+    /// Reopens the output file of a restarted run. The lines written after its checkpoint are removed
+    /// (i.e. it is truncated to the given size) and the run continues writing after them.
+    void resumeOutputFile( string name, long size );
+
+    /// Writes what is buffered and returns the size of the output file.
+    long getOutputSize();
+
     /// Closes the output file.
     void closeOutputFile();
 
@@ -253,6 +263,42 @@ class IO: public Pointers
     /// The keyword for reporting additionl properties (currently only supports coverages)
     string m_sReport;
 
+    /// The keyword for the method selecting the process class of the next event
+    string m_sSelection;
+
+    /// The keyword for the debug mode
+    string m_sDebug;
+
+    /// The keyword for the method advancing the simulation (direct method or next reaction method)
+    string m_sScheduler;
+
+    /// The keyword for the parallel (synchronous sublattice) run
+    string m_sParallel;
+
+    /// The keyword for the ensemble of runs
+    string m_sEnsemble;
+
+    /// The keyword for the parameter sweep
+    string m_sSweep;
+
+    /// The keyword for the number of threads performing the runs of an ensemble or a sweep
+    string m_sThreads;
+
+    /// The keyword for writing checkpoints
+    string m_sCheckpoint;
+
+    /// The keyword for restarting from a checkpoint
+    string m_sRestart;
+
+    /// The keyword for the order of the sites in the storage
+    string m_sOrdering;
+
+    /// The keyword for the acceleration of the quasi-equilibrated fast processes
+    string m_sAcceleration;
+
+    /// The path of the output files
+    string m_sOutputPath;
+
     // trim from start (in place)
     static inline void ltrim(std::string &s) {
         s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch) {
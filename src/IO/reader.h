@@ -23,7 +23,6 @@
 #include "diffusion.h"
 #include "reaction.h"
 
-#define EXIT { printf("Apothesis terminated. \n"); exit( EXIT_FAILURE ); }
 
 using namespace std;
 using namespace Utils;
@@ -32,25 +32,74 @@
 #include "reaction.h"
 
 #include "factory_process.h"
+#include "selector.h"
+#include "next_reaction_scheduler.h"
+#include "synchronous_sublattice.h"
+#include "site_class.h"
+#include "bond_class.h"
+#include "checkpoint.h"
+#include "rate_scaling.h"
 
 #include <numeric>
 #include <algorithm>
+#include <atomic>
+#include <csignal>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace MicroProcesses;
 
 //using namespace Utils;
 
-Apothesis::Apothesis(int argc, char *argv[])
+/// The signals received for writing a checkpoint (SIGUSR1) and for writing a checkpoint and stopping (SIGTERM).
+/// They are counted (not flagged) so every instance of apothesis running in the process handles each signal.
+static atomic<int> iCheckpointSignals( 0 );
+static atomic<int> iStopSignals( 0 );
+
+static void checkpointSignal( int signal )
+{
+    if ( signal == SIGTERM )
+        iStopSignals++;
+    else
+        iCheckpointSignals++;
+}
+
+Apothesis::Apothesis(int argc, char *argv[], string outputPath)
     : pLattice(0),
       pReader(0),
       m_dProcTime(0.0),
       m_dRTot(0.0),
       m_dProcRate(0.0),
-      m_debugMode(false)
+      m_debugMode(false),
+      m_pSelector(0),
+      m_pScheduler(0),
+      m_pParallel(0),
+      m_pScaling(0),
+      m_iEvents(0),
+      m_iResumEvery(100000),
+      m_dMaxDrift(0.0),
+      m_iEvaluatedRules(0),
+      m_iSkippedRules(0),
+      m_bInputRead(false),
+      m_bBuilt(false),
+      m_iSeed(0),
+      m_bRecord(false),
+      m_iSamples(0),
+      m_bRestarted(false),
+      m_iCheckpointSignals(0),
+      m_iStopSignals(0),
+      m_dTimeToCheckpoint(0.0),
+      m_dTimeToWriteLog(0.0),
+      m_dTimeToWriteLattice(0.0),
+      m_dMeanDHPrevStep(0.0),
+      m_dPrevTimeStep(0.0)
 {
     m_iArgc = argc;
     m_vcArgv = argv;
 
+    pErrorHandler = new Utils::ErrorHandler(this);
     pParameters = new Utils::Parameters(this);
     pProperties = new Utils::Properties(this);
     pRandomGen = new RandomGen::RandomGenerator( this );
@@ -60,6 +109,7 @@ Apothesis::Apothesis(int argc, char *argv[])
 
     // Create input instance
     pIO = new IO(this);
+    pIO->setOutputPath( outputPath );
     pIO->init(m_iArgc, m_vcArgv);
 
     // initialize number of species
@@ -68,22 +118,45 @@ Apothesis::Apothesis(int argc, char *argv[])
 
 Apothesis::~Apothesis()
 {
+    for ( auto &p:m_processMap )
+        delete p.first;
+
+    for ( Engine::BondClass* bondClass:m_vBondClasses )
+        delete bondClass;
+
     delete pIO;
     delete pReader;
     delete pLattice;
     delete pParameters;
+    delete pProperties;
     delete pErrorHandler;
     delete pRandomGen;
+    delete m_pSelector;
+    delete m_pScheduler;
+    delete m_pParallel;
+    delete m_pScaling;
 }
 
-void Apothesis::init()
+void Apothesis::readInput()
 {
-    //Read the input file
+    if ( m_bInputRead )
+        return;
+
     pIO->readInputFile();
+    m_bInputRead = true;
+}
 
-    //Open the output file
-    if ( !pIO->outputOpen() )
-        pIO->openOutputFile("Output");
+void Apothesis::build( Apothesis* base )
+{
+    if ( m_bBuilt )
+        return;
+
+    //Read the input file
+    readInput();
+
+    //The caller may give its own random generator initializer (e.g. every run of an ensemble)
+    if ( m_iSeed != 0 )
+        pParameters->setRandGenInit( m_iSeed );
 
     // Initialize Random generator
     if ( pParameters->getRandGenInit() != 0.0 )
@@ -91,20 +164,27 @@ void Apothesis::init()
     else
         pRandomGen->init( time(nullptr) );
 
-    //Create the lattice
+    //Create the lattice. If a lattice has already been built from the same input it is copied.
     pLattice->setLabels( pParameters->getLatticeLabels() );
-    pLattice->build();
+    if ( base )
+        pLattice->copyFrom( base->pLattice );
+    else {
+        pLattice->build();
 
-    // TODO: Here we must take into account the case of two or more species participating in the film growth
-    // and the user should give the per cent of each species in t=0s e.g. 0.8Ga 0.2As
-    for ( Site* s:pLattice->getSites() ){
-        s->setLabel(  pParameters->getLatticeLabels() );
-        s->setBelowLabel(  pParameters->getLatticeLabels() );
-        s->setOccupied( false ); //Start from clear surface
-    }
+        // TODO: Here we must take into account the case of two or more species participating in the film growth
+        // and the user should give the per cent of each species in t=0s e.g. 0.8Ga 0.2As
+        for ( Site* s:pLattice->getSites() ){
+            s->setLabel(  pParameters->getLatticeLabels() );
+            s->setBelowLabel(  pParameters->getLatticeLabels() );
+            s->setOccupied( false ); //Start from clear surface
+        }
+
+        if ( pLattice->hasSteps() )
+            pLattice->buildSteps();
 
-    if ( pLattice->hasSteps() )
-        pLattice->buildSteps();
+        pLattice->computeCoordination();
+        pLattice->computeSurfaceSums();
+    }
 
     //Print lattice info: To be move in debug version
     pLattice->printInfo();
@@ -114,10 +194,11 @@ void Apothesis::init()
     //Print parameters to check: To be move in debug version
     pParameters->printInfo();
 
-    //An empty set used for the initialization of the processMap
-    set< Site* > emptySet;
+    //An empty class used for the initialization of the processMap
+    Engine::SiteClass emptyClass( pLattice->getSize() );
 
-    //Create the processes
+    //Create the processes. The equation that created each is kept (e.g. to find the reverse processes).
+    unordered_map<Process*, string> equations;
     for ( auto proc:pParameters->getProcessesInfo() ){
 
         string process = mf_analyzeProc( proc.first );
@@ -148,7 +229,7 @@ void Apothesis::init()
                 a->setSysParams( pParameters ); //These are the systems and constants parameters
                 a->init( proc.second ); //These are the process per se parameters
 
-                m_processMap.insert( {a, emptySet} );
+                m_processMap.insert( {a, emptyClass} );
 
             } else {
 
@@ -169,7 +250,7 @@ void Apothesis::init()
                     a->setSysParams( pParameters ); //These are the systems and constants parameters
                     a->init( proc.second ); //These are the process per se parameters
 
-                    m_processMap.insert( {a, emptySet} );
+                    m_processMap.insert( {a, emptyClass} );
                 }
             }
         }
@@ -215,7 +296,7 @@ void Apothesis::init()
 
             r->init( proc.second ); //These are the process per se parameters
 
-            m_processMap.insert( {r, emptySet} );
+            m_processMap.insert( {r, emptyClass} );
         }
         else if ( process.compare("Desorption") == 0 ){
 
@@ -239,6 +320,10 @@ void Apothesis::init()
                         des->setDesorbed( s.first );
                 }
 
+                for ( pair<string, int> s: reactants )
+                    if ( s.first.compare("*") != 0 )
+                        des->setReactant( s.first, s.second );
+
                 des->setName( proc.first );
                 des->setLattice( pLattice );
                 des->setRandomGen( pRandomGen );
@@ -246,7 +331,7 @@ void Apothesis::init()
                 des->setSysParams( pParameters ); //These are the systems and constants parameters
                 des->init( proc.second ); //These are the process per se parameters
 
-                m_processMap.insert( {des, emptySet} );
+                m_processMap.insert( {des, emptyClass} );
 
             } else {
                 for ( int neighs = 0; neighs < pLattice->getNumFirstNeihgs(); neighs++) {
@@ -258,6 +343,10 @@ void Apothesis::init()
                             des->setDesorbed( s.first );
                     }
 
+                    for ( pair<string, int> s: reactants )
+                        if ( s.first.compare("*") != 0 )
+                            des->setReactant( s.first, s.second );
+
                     des->setNumNeighs( neighs );
                     des->setAllNeighs(true);
                     des->setName( proc.first + " (" + to_string(neighs + 1) + " N)" );
@@ -267,7 +356,7 @@ void Apothesis::init()
                     des->setSysParams( pParameters ); //These are the systems and constants parameters
                     des->init( proc.second ); //These are the process per se parameters
 
-                    m_processMap.insert( {des, emptySet} );
+                    m_processMap.insert( {des, emptyClass} );
                 }
             }
         }
@@ -304,7 +393,7 @@ void Apothesis::init()
                 dif->setSysParams( pParameters ); //These are the systems and constants parameters
                 dif->init( proc.second ); //These are the process per se parameters
 
-                m_processMap.insert( {dif, emptySet} );
+                m_processMap.insert( {dif, emptyClass} );
 
             } else {
 
@@ -333,10 +422,14 @@ void Apothesis::init()
                     dif->setSysParams( pParameters ); //These are the systems and constants parameters
                     dif->init( proc.second ); //These are the process per se parameters
 
-                    m_processMap.insert( {dif, emptySet} );
+                    m_processMap.insert( {dif, emptyClass} );
                 }
             }
         }
+
+        for ( auto &p:m_processMap )
+            if ( equations.find( p.first ) == equations.end() )
+                equations[ p.first ] = proc.first;
     }
 
 
@@ -361,21 +454,231 @@ void Apothesis::init()
     pLattice->getSite( 19)->setOccupied(true);
     pLattice->getSite( 19)->setLabel("CO*");*/
 
-    //Partition the lattice sites depending on the rules of each process
-    for ( auto &p:m_processMap ){
+    //Number the processes. The ID is the position of the process in the event selection.
+    //They are numbered by name (not by their order in the map which depends on their addresses) so every run is reproducible.
+    for ( auto &p:m_processMap )
+        m_vProcesses.push_back( p.first );
+
+    sort( m_vProcesses.begin(), m_vProcesses.end(), []( Process* a, Process* b ){ return a->getName() < b->getName(); } );
+
+    for ( int iID = 0; iID < (int)m_vProcesses.size(); iID++ ){
+        m_vProcesses[ iID ]->setID( iID );
+        m_vClasses.push_back( &m_processMap[ m_vProcesses[ iID ] ] );
+        m_vsEquations.push_back( equations[ m_vProcesses[ iID ] ] );
+    }
+
+    //The classes of every site are kept in a mask of the process IDs
+    if ( m_vProcesses.size() > 8*sizeof( SurfaceTiles::ClassMask ) ){
+        pErrorHandler->error_simple_msg("At most " + to_string( 8*sizeof( SurfaceTiles::ClassMask ) ) + " processes are supported ("
+                                        + to_string( m_vProcesses.size() ) + " are given).");
+        EXIT
+    }
+
+    //The processes have registered their species so the sites of each can be counted
+    pLattice->computeSpeciesCounts();
+
+    //Partition the lattice sites depending on the rules of each process.
+    //The rules do not depend on the rate constants so the partition of the base is copied (the processes are matched by name).
+    //A process that is accepted in every site has the implicit class of the whole lattice.
+    if ( base ){
+        unordered_map<string, Engine::SiteClass*> baseClasses;
+        for ( auto &p:base->m_processMap )
+            baseClasses[ p.first->getName() ] = &p.second;
+
+        for ( auto &p:m_processMap ){
+            if ( baseClasses.find( p.first->getName() ) == baseClasses.end() ){
+                pErrorHandler->error_simple_msg("The process " + p.first->getName() + " is not found in the lattice that is copied.");
+                EXIT
+            }
+
+            if ( p.first->isUncoAccepted() ){
+                p.second.setAll( &pLattice->getSites() );
+                continue;
+            }
+
+            for ( Site* s:baseClasses[ p.first->getName() ]->getSites() )
+                p.second.insert( pLattice->getSite( s->getID() ) );
+        }
+    }
+    else {
+        for ( auto &p:m_processMap ){
+            if ( p.first->isUncoAccepted() ){
+                p.second.setAll( &pLattice->getSites() );
+                continue;
+            }
+
+            for ( Site* s:pLattice->getSites() ){
+                if ( p.first->rules( s ) )
+                    p.second.insert( s );
+            }
+        }
+    }
+
+    //The pair processes have the classes of their bonds instead (the bonds of the base are copied by their IDs)
+    for ( Process* p:m_vProcesses ){
+        if ( !p->isPairProcess() ){
+            m_vBondClasses.push_back( 0 );
+            continue;
+        }
+
+        Engine::BondClass* bondClass = new Engine::BondClass( pLattice->getNumBonds() );
+        m_vBondClasses.push_back( bondClass );
+
+        if ( base ){
+            Engine::BondClass* baseClass = 0;
+            for ( Process* p2:base->m_vProcesses )
+                if ( p2->getName() == p->getName() )
+                    baseClass = base->m_vBondClasses[ p2->getID() ];
+
+            if ( baseClass ){
+                for ( const Engine::Bond& bond:baseClass->getBonds() )
+                    bondClass->insert( bond.iID, pLattice->getBondSite( bond.iID ), pLattice->getBondNeighbour( bond.iID ) );
+                continue;
+            }
+        }
+
         for ( Site* s:pLattice->getSites() ){
-            if ( p.first->rules( s ) )
-                p.second.insert( s );
+            NeighbourSpan neighs = s->getNeighs();
+            for ( int i = 0; i < (int)neighs.size(); i++ )
+                if ( p->pairRules( s, neighs[ i ] ) )
+                    bondClass->insert( s->getBond( i ), s, neighs[ i ] );
+        }
+    }
+
+    mf_buildClassMasks();
+
+    m_bBuilt = true;
+}
+
+void Apothesis::init()
+{
+    build();
+
+    //A restarted run takes its state from the checkpoint (relative to the output path) and continues its output file
+    string sRestart = pParameters->getRestartFile();
+    m_bRestarted = !sRestart.empty();
+    if ( m_bRestarted && sRestart.front() != BAC )
+        sRestart = pIO->getOutputPath() + sRestart;
+
+    if ( ( m_bRestarted || pParameters->getCheckpoint() ) && pParameters->getParallelDomains() > 0 ){
+        pErrorHandler->error_simple_msg("Checkpoints cannot be written or restarted in a parallel run.");
+        EXIT
+    }
+
+    //The rates of the cells of a coarse-grained lattice depend on their numbers of species which the checkpoints do not keep
+    if ( pLattice->getType() == Lattice::CoarseGrained ){
+        if ( pParameters->getScheduler().compare("nrm") != 0 ){
+            pErrorHandler->error_simple_msg("The coarse-grained lattice needs the next reaction method (scheduler: nrm) as the rates of its cells depend on their occupancies.");
+            EXIT
+        }
+
+        if ( m_bRestarted || pParameters->getCheckpoint() ){
+            pErrorHandler->error_simple_msg("Checkpoints cannot be written or restarted with a coarse-grained lattice.");
+            EXIT
         }
     }
 
+    //Open the output file
+    if ( !pIO->outputOpen() && !m_bRestarted )
+        pIO->openOutputFile("Output");
+
+    //Create the selection method and give it the rate of each class
+    m_pSelector = Engine::Selector::create( pParameters->getSelection(), pRandomGen );
+
+    //The fast processes that are quasi-equilibrated are scaled down if the run is accelerated (every factor starts from 1)
+    if ( pParameters->getAccelerationStage() > 0 ){
+        if ( pParameters->getParallelDomains() > 0 ){
+            pErrorHandler->error_simple_msg("The acceleration cannot be used in a parallel run.");
+            EXIT
+        }
+
+        m_pScaling = new Engine::RateScaling( pParameters->getAccelerationStage(), pParameters->getAccelerationTolerance(), pParameters->getAccelerationFast(),
+                                              pParameters->getAccelerationMinimum() );
+        mf_initScaling();
+    }
+
+    m_pSelector->init( m_vProcesses.size() );
+    for ( Process* p:m_vProcesses )
+        m_pSelector->update( p->getID(), mf_rate( p )*(double)mf_classSize( p->getID() ) );
+
+    //For the next reaction method every process in every site of its class is scheduled (a restarted run reads its schedule)
+    if ( pParameters->getScheduler().compare("nrm") == 0 ){
+        m_pScheduler = new Engine::NextReactionScheduler( pRandomGen );
+        //The events of the pair processes are identified by their bonds
+        vector<int> vEvents;
+        for ( Process* p:m_vProcesses )
+            vEvents.push_back( p->isPairProcess() ? pLattice->getNumBonds() : pLattice->getSize() );
+
+        m_pScheduler->init( vEvents );
+
+        if ( !m_bRestarted )
+            for ( Process* p:m_vProcesses ){
+                if ( p->isPairProcess() ){
+                    for ( const Engine::Bond& bond:m_vBondClasses[ p->getID() ]->getBonds() )
+                        m_pScheduler->update( p->getID(), bond.iID, p->getPairRate( bond.pSite, bond.pNeighbour )*mf_factor( p ), 0.0 );
+                    continue;
+                }
+
+                for ( Site* s:m_vClasses[ p->getID() ]->getSites() )
+                    m_pScheduler->update( p->getID(), s->getID(), p->getRate( s )*mf_factor( p ), 0.0 );
+            }
+    }
+
+    //For the parallel run the lattice is partitioned in domains which start from the classes built above.
+    //Every domain gets its own random generator seeded from the main one, so the run is reproducible.
+    if ( pParameters->getParallelDomains() > 0 ){
+        if ( m_pScheduler ){
+            pErrorHandler->error_simple_msg("The next reaction method cannot be used in a parallel run.");
+            EXIT
+        }
+
+        m_pParallel = new Engine::SynchronousSublattice( pLattice, pParameters->getParallelDomains(), pParameters->getParallelWindow() );
+
+        if ( m_pParallel->getMinWidth() < Engine::SynchronousSublattice::iMinWidth ){
+            pErrorHandler->error_simple_msg("The lattice is too small for " + to_string( m_pParallel->getNumDomains() ) + " domains. Every domain must be at least "
+                                            + to_string( 2*Engine::SynchronousSublattice::iMinWidth ) + " sites wide in x and y.");
+            EXIT
+        }
+
+        vector<RandomGen::RandomGenerator*> vRandomGens;
+        for ( int d = 0; d < m_pParallel->getNumDomains(); d++ ){
+            RandomGen::RandomGenerator* randomGen = new RandomGen::RandomGenerator( this );
+            randomGen->init( pRandomGen->getIntRandom( 0, INT_MAX - 1 ) );
+            vRandomGens.push_back( randomGen );
+        }
+
+        vector<const Engine::SiteClass*> vClasses;
+        vector<const Engine::BondClass*> vBondClasses;
+        for ( Process* p:m_vProcesses ){
+            vClasses.push_back( &m_processMap[ p ] );
+            vBondClasses.push_back( m_vBondClasses[ p->getID() ] );
+        }
+
+        m_pParallel->init( m_vProcesses, vClasses, vBondClasses, vRandomGens, pParameters->getSelection() );
+    }
+
     //The end time of the simulation
     m_dEndTime = pParameters->getEndTime();
 
+    m_bHasGrowth = pParameters->getGrowthSpecies().size() > 0 ? true : false;
+    m_bReportCoverages = pParameters->getCoverageSpecies().size() > 0 ? true : false;
+
+    //Checkpoints are written when the process is signaled: SIGUSR1 writes a checkpoint, SIGTERM writes a checkpoint and stops the run
+    if ( pParameters->getCheckpoint() ){
+        m_iCheckpointSignals = iCheckpointSignals;
+        m_iStopSignals = iStopSignals;
+
+        signal( SIGUSR1, checkpointSignal );
+        signal( SIGTERM, checkpointSignal );
+    }
+
+    if ( m_bRestarted ){
+        pIO->resumeOutputFile( "Output", mf_readCheckpoint( sRestart ) );
+        return;
+    }
+
     //Calculate first time the total probability (R) for apothesis to start --------------------------//
-    m_dRTot = 0.0;
-    for (pair<Process*, set< Site* > > p:m_processMap)
-        m_dRTot += p.first->getRateConstant()*(double)p.second.size();
+    m_dRTot = m_pSelector->getTotalRate();
 
     //Start writing in the output log
     //Write initialization info to log
@@ -386,6 +689,24 @@ void Apothesis::init()
     pIO->writeLogOutput("Temperature " + to_string( pParameters->getTemperature() ) + " K");
     pIO->writeLogOutput("Pressure " + to_string( pParameters->getPressure() ) + " P");
     pIO->writeLogOutput("Random init num " + to_string( pParameters->getRandGenInit() ) );
+    pIO->writeLogOutput("Selection " + m_pSelector->getName() );
+    pIO->writeLogOutput("Scheduler " + pParameters->getScheduler() );
+    pIO->writeLogOutput("Memory per site " + to_string( pLattice->getMemoryPerSite() ) + " bytes" );
+    pIO->writeLogOutput("Site ordering " + string( pLattice->getOrdering() == Lattice::MORTON ? "morton" : "row-major" ) );
+
+    if ( m_pScaling )
+        pIO->writeLogOutput("Acceleration stage " + to_string( pParameters->getAccelerationStage() ) + " events tolerance "
+                            + to_string( pParameters->getAccelerationTolerance() ) + " fast ratio " + to_string( pParameters->getAccelerationFast() )
+                            + " minimum executions " + to_string( m_pScaling->getMinimum() ) );
+
+    if ( m_pParallel ){
+        int iThreads = 1;
+#ifdef _OPENMP
+        iThreads = omp_get_max_threads();
+#endif
+        pIO->writeLogOutput("Parallel " + to_string( m_pParallel->getNumDomains() ) + " domains (" + to_string( m_pParallel->getDomainsX() ) + " x "
+                            + to_string( m_pParallel->getDomainsY() ) + ") window " + to_string( m_pParallel->getWindow() ) + " sec threads " + to_string( iThreads ) );
+    }
 
     string toWrite = "\n";
     toWrite = "Lattice " +  pLattice->getTypeAsString() + " ";
@@ -415,20 +736,20 @@ void Apothesis::init()
 
     string output = "Time (s)"s + '\t' + "Growth rate (ML/s)" + '\t' + "RMS (-)" + '\t' + "Micro-roughness (-)" + '\t';
 
-    for ( auto &p:m_processMap)
-        output += p.first->getName() + '\t';
+    for ( Process* p:m_vProcesses )
+        output += p->getName() + '\t';
 
-    for ( auto &p:m_processMap)
-        output +=  p.first->getName() + " (class size)" + '\t';
+    for ( Process* p:m_vProcesses )
+        output +=  p->getName() + " (class size)" + '\t';
 
-    m_bHasGrowth = pParameters->getGrowthSpecies().size() > 0 ? true : false;
-    m_bReportCoverages = pParameters->getCoverageSpecies().size() > 0 ? true : false;
+    if ( m_pScaling )
+        for ( Process* p:m_vProcesses )
+            output +=  p->getName() + " (scaling)" + '\t';
 
     // If the user wants the coverages to be reported
     if ( m_bReportCoverages ){
-        unordered_map<string, double> covs = pLattice->computeCoverages( pParameters->getCoverageSpecies() );
-        for ( auto &p:covs)
-            output +=  p.first + " (coverage)" + '\t';
+        for ( string species:pParameters->getCoverageSpecies() )
+            output +=  species + " (coverage)" + '\t';
     }
 
     pIO->writeInOutput( output );
@@ -442,107 +763,170 @@ void Apothesis::init()
 
 void Apothesis::exec()
 {
-    double timeToWriteLog = 0;
-    double timeToWriteLattice = 0;
-
     string output ="";
 
     //    pLattice->writeXYZ( "initial.xzy" );
 
-    // The average height for the first time
     double timeGrowth = 0;
-    double meanDHPrevStep = pProperties->getMeanDH();
-    double prevTimeStep = 0.0;
-
-    ostringstream streamObj;
-    streamObj.precision(15);
-    streamObj << m_dProcTime;
-    //output = std::to_string( m_dProcTime ) + '\t'
-    output = streamObj.str() + '\t'
-            + std::to_string( 0.0  ) + '\t'
-            + std::to_string( pProperties->getRMS() )  + '\t'
-            + std::to_string( pProperties->getMicroroughness() )  + '\t';
-
-    for ( auto &p:m_processMap)
-        output += std::to_string( p.first->getNumEventHappened() ) + '\t';
-
-    for ( auto &p:m_processMap)
-        output += std::to_string( p.second.size() ) + '\t';
 
-    if ( m_bReportCoverages ) {
-        unordered_map<string, double> covs = pLattice->computeCoverages( pParameters->getCoverageSpecies() );
+    //A restarted run has already written its initial state
+    if ( !m_bRestarted ){
+        // The average height for the first time
+        m_dTimeToWriteLog = 0.0;
+        m_dTimeToWriteLattice = 0.0;
+        m_dMeanDHPrevStep = pProperties->getMeanDH();
+        m_dPrevTimeStep = 0.0;
+
+        ostringstream streamObj;
+        streamObj.precision(15);
+        streamObj << m_dProcTime;
+        //output = std::to_string( m_dProcTime ) + '\t'
+        output = streamObj.str() + '\t'
+                + std::to_string( 0.0  ) + '\t'
+                + std::to_string( pProperties->getRMS() )  + '\t'
+                + std::to_string( pProperties->getMicroroughness() )  + '\t';
+
+        for ( Process* p:m_vProcesses )
+            output += std::to_string( mf_getNumEventHappened( p ) ) + '\t';
+
+        for ( Process* p:m_vProcesses )
+            output += std::to_string( mf_getClassSize( p ) ) + '\t';
+
+        if ( m_pScaling )
+            for ( Process* p:m_vProcesses )
+                output += std::to_string( mf_factor( p ) ) + '\t';
+
+        if ( m_bReportCoverages ) {
+            vector<double> covs = pLattice->computeCoverages( pParameters->getCoverageSpeciesIDs() );
+
+            for ( double coverage:covs )
+                output += std::to_string( coverage ) + '\t';
+        }
 
-        for ( auto &p:covs)
-            output += std::to_string( p.second ) + '\t';
+        pIO->writeInOutput( output );
     }
 
-    pIO->writeInOutput( output );
+    m_tLastCheckpoint = chrono::steady_clock::now();
+
+    //The simulated and the wall clock time of this run (for the speed-up of the acceleration)
+    chrono::steady_clock::time_point tStart = m_tLastCheckpoint;
+    double dStartTime = m_dProcTime;
 
     while ( m_dProcTime <= m_dEndTime ){
-        //1. Get a random numbers
-        m_dSum = 0.0;
-        m_iRandom = pRandomGen->getDoubleRandom();
+        Process* proc = 0;
+        Site* s = 0;
 
-        for ( auto &p:m_processMap){
-            m_dProcRate = p.first->getRateConstant()*(double)p.second.size();
-            m_dSum += m_dProcRate/m_dRTot;
+        //The neighbour and the bond of the event of a pair process
+        Site* neigh = 0;
+        int iBond = -1;
 
-            //2. Pick a process according to the rates
-            if ( m_iRandom <= m_dSum ){
+        if ( m_pParallel ){
+            //1.-5. Synchronous sublattice: every domain performs the events of the same randomly chosen sublattice for the time window
+            m_pParallel->cycle( pRandomGen->getIntRandom( 0, 3 ) );
+            m_dt = m_pParallel->getCycleTime();
+        }
+        else if ( m_pScheduler ){
+            //1.-3. Next reaction method: the event with the earliest firing time is performed
+            if ( m_pScheduler->empty() )
+                break;
+
+            proc = m_vProcesses[ m_pScheduler->getNextProcess() ];
+            if ( proc->isPairProcess() ){
+                iBond = m_pScheduler->getNextSite();
+                s = pLattice->getBondSite( iBond );
+                neigh = pLattice->getBondNeighbour( iBond );
+            }
+            else
+                s = pLattice->getSite( m_pScheduler->getNextSite() );
 
-                // Calculate the average Height before
-                //                aveDH1 = pProperties->getMeanDH();
+            m_dt = m_pScheduler->getNextTime() - m_dProcTime;
+        }
+        else {
+            //1. Get a random numbers
+            m_iRandom = pRandomGen->getDoubleRandom();
+
+            //2. Pick a process according to the rates
+            int iProc = m_pSelector->select( m_iRandom );
+            if ( iProc >= 0 && m_vBondClasses[ iProc ] ){
+                //A pair process is performed in a random bond of its class
+                proc = m_vProcesses[ iProc ];
+                const Engine::Bond& bond = m_vBondClasses[ iProc ]->getBond( pRandomGen->getIntRandom( 0, m_vBondClasses[ iProc ]->size() - 1 ) );
+                iBond = bond.iID;
+                s = bond.pSite;
+                neigh = bond.pNeighbour;
+            }
+            else if ( iProc >= 0 ){
+                proc = m_vProcesses[ iProc ];
+                Engine::SiteClass& procClass = *m_vClasses[ iProc ];
 
                 //Get a random number which is the ID of the site where this process can performed
-                m_iSiteNum = pRandomGen->getIntRandom(0, p.second.size() - 1 );
+                m_iSiteNum = pRandomGen->getIntRandom(0, procClass.size() - 1 );
 
                 //3. From this process pick the random site with id and perform it:
-                Site* s = *next( p.second.begin(), m_iSiteNum );
-
-                //Compute the average height before performing the process to measure the growth rate
-                timeGrowth = m_dProcTime;
-
-                p.first->perform( s );
-
-                //Count the event for this class
-                p.first->eventHappened();
-
-                // Check if an affected site must enter tob a class or not
-                for (Site* affectedSite:p.first->getAffectedSites() ){
-                    //Erase the affected site from the processes
-                    for (auto &p2:m_processMap){
-                        if ( !p2.first->isUncoAccepted() ) {
-                            //Added if it obeys the rules of this process
-                            if ( p2.first->rules( affectedSite ) ) {
-                                if (p2.second.find( affectedSite ) == p2.second.end() )
-                                    p2.second.insert( affectedSite );
-                            }
-                            else
-                                p2.second.erase( affectedSite );
-                        }
-                    }
-                }
+                s = procClass.getSite( m_iSiteNum );
+            }
+        }
 
-                //4. Re-compute the processes rates and re-compute Rtot (see ppt)
-                m_dRTot = 0.0;
-                for (pair<Process*, set< Site* > > p3:m_processMap)
-                    m_dRTot += p3.first->getRateConstant()*(double)p3.second.size();
+        if ( proc ){
+            //Compute the average height before performing the process to measure the growth rate
+            timeGrowth = m_dProcTime;
 
-                //5. Compute dt = -ln(ksi)/Rtot
-                m_dt = -log( pRandomGen->getDoubleRandom()  )/m_dRTot;
-//                                cout << m_dt << endl;
-                break;
+            //The acceleration counts a hop with the change of the coordination of what it moved
+            bool bHop = m_pScaling && neigh && m_pScaling->isOwnReverse( proc->getID() );
+            int iCoordination = bHop ? proc->getCoordination( s ) : 0;
+
+            if ( neigh )
+                proc->performPair( s, neigh );
+            else
+                proc->perform( s );
+
+            //Count the event for this class
+            proc->eventHappened();
+
+            //The time of this event. For the next reaction method the event that fired gets a new firing time.
+            double dEventTime = m_dProcTime + m_dt;
+            if ( m_pScheduler )
+                m_pScheduler->fired( proc->getID(), neigh ? iBond : s->getID(), dEventTime );
+
+            //Update the classes (and the rates) of the processes in the sites affected by the perform
+            mf_update( proc->getWrites(), proc->getModifiedSites(), proc->getAffectedSites(), dEventTime );
+
+            //At the end of every stage of the acceleration the quasi-equilibrated fast processes are scaled
+            if ( m_pScaling && m_pScaling->count( proc->getID(), bHop ? proc->getCoordination( neigh ) - iCoordination : 0 ) )
+                mf_endStage( dEventTime );
+
+            //4. Rtot is updated by the selection every time a class changes size (see ppt).
+            //   Every m_iResumEvery events it is recomputed exactly to remove the round-off drift.
+            m_iEvents++;
+            if ( m_iEvents%m_iResumEvery == 0 ){
+                double dDrift = mf_resumRates();
+
+                if ( m_debugMode )
+                    cout << "Events " << m_iEvents << " Rtot " << m_dRTot << " drift " << dDrift << " (relative " << dDrift/m_dRTot << ")" << endl;
             }
+            else
+                m_dRTot = m_pSelector->getTotalRate();
+
+            //5. Compute dt = -ln(ksi)/Rtot (the next reaction method has already computed it from the firing time)
+            if ( !m_pScheduler )
+                m_dt = -log( pRandomGen->getDoubleRandom()  )/m_dRTot;
         }
 
+        //The state holds until the next event so it is recorded for the sampling times before it
+        if ( m_bRecord )
+            mf_record( m_dProcTime + m_dt );
+
         //6. advance time: time += dt;
         m_dProcTime += m_dt;
 
         //Here compute the time for writing
-        timeToWriteLog += m_dt;
-        timeToWriteLattice += m_dt;
+        m_dTimeToWriteLog += m_dt;
+        m_dTimeToWriteLattice += m_dt;
 
-        if ( timeToWriteLog >= pParameters->getWriteLogTimeStep() ){
+        if ( m_dTimeToWriteLog >= pParameters->getWriteLogTimeStep() ){
+
+            if ( m_debugMode )
+                pProperties->checkSurfaceSums();
 
             ostringstream streamObj;
             streamObj.precision(15);
@@ -550,34 +934,38 @@ void Apothesis::exec()
             streamObj << m_dProcTime;
 
             output = streamObj.str() + '\t'
-                    + std::to_string( (pProperties->getMeanDH() - meanDHPrevStep) / ( ((m_dProcTime - prevTimeStep) ) ) )+ '\t'
+                    + std::to_string( (pProperties->getMeanDH() - m_dMeanDHPrevStep) / ( ((m_dProcTime - m_dPrevTimeStep) ) ) )+ '\t'
                     + std::to_string( pProperties->getRMS() )  + '\t'
                     + std::to_string( pProperties->getMicroroughness() )  + '\t';
 
-            cout << pProperties->getMeanDH()  <<  " " << meanDHPrevStep <<  " " << m_dProcTime << " " << prevTimeStep << " " <<  pProperties->getMeanDH() - meanDHPrevStep << endl;
+            cout << pProperties->getMeanDH()  <<  " " << m_dMeanDHPrevStep <<  " " << m_dProcTime << " " << m_dPrevTimeStep << " " <<  pProperties->getMeanDH() - m_dMeanDHPrevStep << endl;
 
             //Store info to be used next time
-            meanDHPrevStep = pProperties->getMeanDH();
-            prevTimeStep = m_dProcTime;
+            m_dMeanDHPrevStep = pProperties->getMeanDH();
+            m_dPrevTimeStep = m_dProcTime;
+
+            for ( Process* p:m_vProcesses )
+                output += std::to_string( mf_getNumEventHappened( p ) ) + '\t';
 
-            for ( auto &p:m_processMap)
-                output += std::to_string( p.first->getNumEventHappened() ) + '\t';
+            for ( Process* p:m_vProcesses )
+                output += std::to_string( mf_getClassSize( p ) ) + '\t';
 
-            for ( auto &p:m_processMap)
-                output += std::to_string( p.second.size() ) + '\t';
+            if ( m_pScaling )
+                for ( Process* p:m_vProcesses )
+                    output += std::to_string( mf_factor( p ) ) + '\t';
 
             if ( m_bReportCoverages ) {
-                unordered_map<string, double> covs = pLattice->computeCoverages( pParameters->getCoverageSpecies() );
+                vector<double> covs = pLattice->computeCoverages( pParameters->getCoverageSpeciesIDs() );
 
-                for ( auto &p:covs)
-                    output += std::to_string( p.second ) + '\t';
+                for ( double coverage:covs )
+                    output += std::to_string( coverage ) + '\t';
             }
 
             pIO->writeInOutput( output );
-            timeToWriteLog = 0.0;
+            m_dTimeToWriteLog = 0.0;
         }
 
-        if ( timeToWriteLattice >= pParameters->getWriteLatticeTimeStep() ) {
+        if ( m_dTimeToWriteLattice >= pParameters->getWriteLatticeTimeStep() ) {
 
             if ( m_bHasGrowth )
                 pIO->writeLatticeHeights( m_dProcTime );
@@ -585,30 +973,69 @@ void Apothesis::exec()
             if ( m_bReportCoverages )
                 pIO->writeLatticeSpecies( m_dProcTime  );
 
-            timeToWriteLattice = 0.0;
+            m_dTimeToWriteLattice = 0.0;
+        }
+
+        //Write a checkpoint every interval of simulated or wall clock time or when the process is signaled
+        if ( pParameters->getCheckpoint() ){
+            bool bWrite = iCheckpointSignals != m_iCheckpointSignals;
+            bool bStop = iStopSignals != m_iStopSignals;
+
+            m_dTimeToCheckpoint += m_dt;
+            if ( pParameters->getCheckpointTime() > 0.0 && m_dTimeToCheckpoint >= pParameters->getCheckpointTime() ){
+                m_dTimeToCheckpoint = 0.0;
+                bWrite = true;
+            }
+
+            chrono::steady_clock::time_point now = chrono::steady_clock::now();
+            if ( pParameters->getCheckpointWallTime() > 0.0 && chrono::duration<double>( now - m_tLastCheckpoint ).count() >= pParameters->getCheckpointWallTime() )
+                bWrite = true;
+
+            if ( bWrite || bStop ){
+                m_iCheckpointSignals = iCheckpointSignals;
+                m_iStopSignals = iStopSignals;
+                m_tLastCheckpoint = now;
+
+                mf_writeCheckpoint();
+            }
+
+            //The output written from here on is removed when the run is restarted
+            if ( bStop ){
+                pIO->writeLogOutput( "Stopped at " + to_string( m_dProcTime ) + " sec after writing the checkpoint." );
+                pIO->closeOutputFile();
+                return;
+            }
         }
     }
 
+    //If no event can be performed the state is recorded up to the end time
+    if ( m_bRecord )
+        mf_record( numeric_limits<double>::infinity() );
+
     ostringstream streamObjEnd;
     streamObjEnd.precision(15);
     streamObjEnd << m_dProcTime;
     //            output = std::to_string( m_dProcTime ) + '\t'
     output = streamObjEnd.str() + '\t'
-            + std::to_string( (pProperties->getMeanDH() - meanDHPrevStep)/ (m_dProcTime - timeToWriteLog)  ) + '\t'
+            + std::to_string( (pProperties->getMeanDH() - m_dMeanDHPrevStep)/ (m_dProcTime - m_dTimeToWriteLog)  ) + '\t'
             + std::to_string( pProperties->getRMS() )  + '\t'
             + std::to_string( pProperties->getMicroroughness() )  + '\t';
 
-    for ( auto &p:m_processMap)
-        output += std::to_string( p.first->getNumEventHappened() ) + '\t';
+    for ( Process* p:m_vProcesses )
+        output += std::to_string( mf_getNumEventHappened( p ) ) + '\t';
+
+    for ( Process* p:m_vProcesses )
+        output += std::to_string( mf_getClassSize( p ) ) + '\t';
 
-    for ( auto &p:m_processMap)
-        output += std::to_string( p.second.size() ) + '\t';
+    if ( m_pScaling )
+        for ( Process* p:m_vProcesses )
+            output += std::to_string( mf_factor( p ) ) + '\t';
 
     if ( m_bReportCoverages ) {
-        unordered_map<string, double> covs = pLattice->computeCoverages( pParameters->getCoverageSpecies() );
+        vector<double> covs = pLattice->computeCoverages( pParameters->getCoverageSpeciesIDs() );
 
-        for ( auto &p:covs)
-            output += std::to_string( p.second ) + '\t';
+        for ( double coverage:covs )
+            output += std::to_string( coverage ) + '\t';
     }
 
     pIO->writeInOutput( output );
@@ -618,6 +1045,560 @@ void Apothesis::exec()
 
     if ( m_bReportCoverages )
         pIO->writeLatticeSpecies( m_dProcTime  );
+
+    if ( m_pParallel ){
+        m_iEvents = m_pParallel->getNumEvents();
+        m_iEvaluatedRules = m_pParallel->getEvaluatedRules();
+        m_iSkippedRules = m_pParallel->getSkippedRules();
+    }
+
+    pIO->writeInOutput( "" );
+    pIO->writeLogOutput( "Events " + to_string( m_iEvents ) );
+    pIO->writeLogOutput( "Rule evaluations " + to_string( m_iEvaluatedRules ) );
+    pIO->writeLogOutput( "Rule evaluations skipped " + to_string( m_iSkippedRules ) );
+
+    if ( m_pScaling ){
+        double dWall = chrono::duration<double>( chrono::steady_clock::now() - tStart ).count();
+
+        pIO->writeLogOutput( "Acceleration stages " + to_string( m_pScaling->getNumStages() ) );
+        for ( Process* p:m_vProcesses )
+            if ( m_pScaling->isReversible( p->getID() ) )
+                pIO->writeLogOutput( "Scaling " + p->getName() + " " + to_string( mf_factor( p ) ) );
+
+        pIO->writeLogOutput( "Simulated seconds per wall second " + to_string( dWall > 0.0 ? ( m_dProcTime - dStartTime )/dWall : 0.0 ) );
+    }
+
+    //In a parallel run the classes and the rates are kept by the domains
+    if ( m_debugMode && !m_pParallel ){
+        double dDrift = mf_resumRates();
+        cout << "Events " << m_iEvents << " Rtot " << m_dRTot << " drift " << dDrift << " (relative " << dDrift/m_dRTot << ")" << endl;
+        cout << "Maximum relative drift of Rtot " << m_dMaxDrift << endl;
+    }
+}
+
+void Apothesis::mf_update( int iWrites, const set<Site*>& modified, const set<Site*>& affected, double time )
+{
+    // Check if an affected site must enter tob a class or not.
+    // A process is re-tested only if the perform wrote an attribute that its rules read
+    // and only in the sites within the radius that its rules read.
+    long iAffected = affected.size();
+
+    //The processes re-tested in the modified sites (radius 0) and in all the affected sites (radius 1)
+    SurfaceTiles::ClassMask iModifiedTests = 0, iAffectedTests = 0;
+    for ( Process* p2:m_vProcesses ){
+        if ( p2->isUncoAccepted() )
+            continue;
+
+        if ( ( p2->getReads() & iWrites ) == 0 ){
+            m_iSkippedRules += iAffected;
+            continue;
+        }
+
+        //The bonds of a pair process are re-tested from every affected site (the bonds to a modified site
+        //start from its neighbours) and its class is updated here
+        if ( p2->isPairProcess() ){
+            bool bResized = false;
+            for ( Site* affectedSite:affected )
+                bResized |= mf_testBonds( p2, affectedSite, time );
+
+            if ( bResized )
+                m_pSelector->update( p2->getID(), mf_rate( p2 )*(double)mf_classSize( p2->getID() ) );
+            continue;
+        }
+
+        const set<Site*>& sites = p2->getRadius() == 0 ? modified : affected;
+        m_iSkippedRules += iAffected - (long)sites.size();
+        m_iEvaluatedRules += sites.size();
+
+        if ( p2->getRadius() == 0 )
+            iModifiedTests |= mf_bit( p2 );
+        else
+            iAffectedTests |= mf_bit( p2 );
+    }
+
+    //Every site gets its new classes from the rules and only the classes that changed are updated.
+    //The sets are walked together in the order of the sites so every class changes in the same order as site by site.
+    SurfaceTiles::ClassMask iResized = 0;
+    set<Site*>::const_iterator itModified = modified.begin(), itAffected = affected.begin();
+    while ( itModified != modified.end() || itAffected != affected.end() ){
+        Site* affectedSite;
+        SurfaceTiles::ClassMask iTests = 0;
+        if ( itAffected == affected.end() || ( itModified != modified.end() && *itModified < *itAffected ) ){
+            affectedSite = *itModified++;
+            iTests = iModifiedTests;
+        }
+        else if ( itModified == modified.end() || *itAffected < *itModified ){
+            affectedSite = *itAffected++;
+            iTests = iAffectedTests;
+        }
+        else {
+            affectedSite = *itAffected++;
+            itModified++;
+            iTests = iModifiedTests | iAffectedTests;
+        }
+
+        SurfaceTiles::ClassMask iOld = affectedSite->getClassMask(), iNew = iOld & ~iTests;
+        for ( SurfaceTiles::ClassMask iBits = iTests; iBits; iBits &= iBits - 1 ){
+            int iProc = __builtin_ctzll( iBits );
+            if ( m_vProcesses[ iProc ]->rules( affectedSite ) )
+                iNew |= (SurfaceTiles::ClassMask)1 << iProc;
+        }
+
+        for ( SurfaceTiles::ClassMask iBits = iOld ^ iNew; iBits; iBits &= iBits - 1 ){
+            int iProc = __builtin_ctzll( iBits );
+            if ( iNew & ( (SurfaceTiles::ClassMask)1 << iProc ) )
+                m_vClasses[ iProc ]->insert( affectedSite );
+            else
+                m_vClasses[ iProc ]->erase( affectedSite );
+        }
+
+        iResized |= iOld ^ iNew;
+        affectedSite->setClassMask( iNew );
+    }
+
+    //Only the leaves of the classes that changed are updated
+    for ( SurfaceTiles::ClassMask iBits = iResized; iBits; iBits &= iBits - 1 ){
+        int iProc = __builtin_ctzll( iBits );
+        m_pSelector->update( iProc, mf_rate( m_vProcesses[ iProc ] )*(double)m_vClasses[ iProc ]->size() );
+    }
+
+    //The rates of the re-tested events may have changed even if their classes did not
+    if ( m_pScheduler ){
+        for ( Process* p2:m_vProcesses ){
+            bool bModified = iModifiedTests & mf_bit( p2 );
+            if ( !bModified && !( iAffectedTests & mf_bit( p2 ) ) )
+                continue;
+
+            for ( Site* affectedSite:( bModified ? modified : affected ) )
+                m_pScheduler->update( p2->getID(), affectedSite->getID(),
+                                      ( affectedSite->getClassMask() & mf_bit( p2 ) ) ? p2->getRate( affectedSite )*mf_factor( p2 ) : 0.0, time );
+        }
+    }
+}
+
+inline uint64_t Apothesis::mf_bit( Process* proc ){ return (uint64_t)1 << proc->getID(); }
+
+void Apothesis::mf_buildClassMasks()
+{
+    for ( Site* s:pLattice->getSites() )
+        s->setClassMask( 0 );
+
+    for ( Process* p:m_vProcesses )
+        for ( Site* s:m_vClasses[ p->getID() ]->getSites() )
+            s->setClassMask( s->getClassMask() | mf_bit( p ) );
+}
+
+int Apothesis::mf_classSize( int process )
+{
+    return m_vBondClasses[ process ] ? m_vBondClasses[ process ]->size() : m_vClasses[ process ]->size();
+}
+
+bool Apothesis::mf_testBonds( Process* proc, Site* s, double time )
+{
+    Engine::BondClass& bondClass = *m_vBondClasses[ proc->getID() ];
+    NeighbourSpan neighs = s->getNeighs();
+    bool bResized = false;
+
+    m_iEvaluatedRules += neighs.size();
+    for ( int i = 0; i < (int)neighs.size(); i++ ){
+        int iBond = s->getBond( i );
+        bool bIn = proc->pairRules( s, neighs[ i ] ), bWasIn = bondClass.contains( iBond );
+
+        //The rate of a bond that stays in the class may have changed (the schedule ignores the same rate)
+        if ( m_pScheduler && ( bIn || bWasIn ) )
+            m_pScheduler->update( proc->getID(), iBond, bIn ? proc->getPairRate( s, neighs[ i ] )*mf_factor( proc ) : 0.0, time );
+
+        if ( bIn == bWasIn )
+            continue;
+
+        if ( bIn )
+            bondClass.insert( iBond, s, neighs[ i ] );
+        else
+            bondClass.erase( iBond );
+
+        bResized = true;
+    }
+
+    return bResized;
+}
+
+double Apothesis::mf_resumRates()
+{
+    for ( Process* p:m_vProcesses )
+        m_pSelector->update( p->getID(), mf_rate( p )*(double)mf_classSize( p->getID() ) );
+
+    double dDrift = m_pSelector->resum();
+    m_dRTot = m_pSelector->getTotalRate();
+
+    if ( m_dRTot > 0.0 && fabs( dDrift/m_dRTot ) > m_dMaxDrift )
+        m_dMaxDrift = fabs( dDrift/m_dRTot );
+
+    return dDrift;
+}
+
+inline double Apothesis::mf_factor( Process* proc )
+{
+    return m_pScaling ? m_pScaling->getFactor( proc->getID() ) : 1.0;
+}
+
+inline double Apothesis::mf_rate( Process* proc )
+{
+    return proc->getRateConstant()*mf_factor( proc );
+}
+
+void Apothesis::mf_initScaling()
+{
+    //The processes of the same equation (e.g. the desorptions for every number of neighbours) are a channel
+    vector<int> vChannels;
+    vector<string> vsChannels;
+    for ( Process* p:m_vProcesses ){
+        vector<string>::iterator it = find( vsChannels.begin(), vsChannels.end(), m_vsEquations[ p->getID() ] );
+        vChannels.push_back( it - vsChannels.begin() );
+        if ( it == vsChannels.end() )
+            vsChannels.push_back( m_vsEquations[ p->getID() ] );
+    }
+
+    //The reactants and the products of every channel with their coefficients
+    vector< vector< pair<string, double> > > vReactants, vProducts;
+    for ( string equation:vsChannels ){
+        vector< pair<string, double> > reactants, products;
+        for ( string react:pIO->getReactants( equation ) )
+            reactants.push_back( pIO->analyzeCompound( react ) );
+        for ( string prod:pIO->getProducts( equation ) )
+            products.push_back( pIO->analyzeCompound( prod ) );
+
+        sort( reactants.begin(), reactants.end() );
+        sort( products.begin(), products.end() );
+        vReactants.push_back( reactants );
+        vProducts.push_back( products );
+    }
+
+    //The reverse of a channel has its products as reactants and its reactants as products (a diffusion is its own reverse)
+    vector<int> vReverse( vsChannels.size(), -1 );
+    for ( unsigned int c = 0; c < vsChannels.size(); c++ )
+        for ( unsigned int r = 0; r < vsChannels.size() && vReverse[ c ] < 0; r++ )
+            if ( vReactants[ c ] == vProducts[ r ] && vProducts[ c ] == vReactants[ r ] )
+                vReverse[ c ] = r;
+
+    m_pScaling->init( vChannels, vReverse );
+}
+
+void Apothesis::mf_endStage( double time )
+{
+    vector<double> vRates;
+    for ( Process* p:m_vProcesses )
+        vRates.push_back( mf_rate( p )*(double)mf_classSize( p->getID() ) );
+
+    if ( !m_pScaling->endStage( vRates ) )
+        return;
+
+    //The rates of every process that may be scaled are updated (the next reaction method rescales the firing times of their events)
+    for ( Process* p:m_vProcesses ){
+        if ( !m_pScaling->isReversible( p->getID() ) )
+            continue;
+
+        m_pSelector->update( p->getID(), mf_rate( p )*(double)mf_classSize( p->getID() ) );
+
+        if ( !m_pScheduler )
+            continue;
+
+        if ( p->isPairProcess() )
+            for ( const Engine::Bond& bond:m_vBondClasses[ p->getID() ]->getBonds() )
+                m_pScheduler->update( p->getID(), bond.iID, p->getPairRate( bond.pSite, bond.pNeighbour )*mf_factor( p ), time );
+        else
+            for ( Site* s:m_vClasses[ p->getID() ]->getSites() )
+                m_pScheduler->update( p->getID(), s->getID(), p->getRate( s )*mf_factor( p ), time );
+    }
+}
+
+void Apothesis::mf_record( double time )
+{
+    double dStep = pParameters->getWriteLogTimeStep();
+
+    if ( m_vsSeriesColumns.empty() ){
+        m_vsSeriesColumns.push_back( "Time (s)" );
+        m_vsSeriesColumns.push_back( "Mean height (-)" );
+        m_vsSeriesColumns.push_back( "RMS (-)" );
+        m_vsSeriesColumns.push_back( "Micro-roughness (-)" );
+
+        for ( Process* p:m_vProcesses )
+            m_vsSeriesColumns.push_back( p->getName() );
+
+        for ( Process* p:m_vProcesses )
+            m_vsSeriesColumns.push_back( p->getName() + " (class size)" );
+
+        if ( m_bReportCoverages )
+            for ( string species:pParameters->getCoverageSpecies() )
+                m_vsSeriesColumns.push_back( species + " (coverage)" );
+    }
+
+    while ( m_iSamples*dStep < time && m_iSamples*dStep <= m_dEndTime ){
+        vector<double> vRow;
+        vRow.push_back( m_iSamples*dStep );
+        vRow.push_back( pProperties->getMeanDH() );
+        vRow.push_back( pProperties->getRMS() );
+        vRow.push_back( pProperties->getMicroroughness() );
+
+        for ( Process* p:m_vProcesses )
+            vRow.push_back( mf_getNumEventHappened( p ) );
+
+        for ( Process* p:m_vProcesses )
+            vRow.push_back( mf_getClassSize( p ) );
+
+        if ( m_bReportCoverages ){
+            vector<double> covs = pLattice->computeCoverages( pParameters->getCoverageSpeciesIDs() );
+            vRow.insert( vRow.end(), covs.begin(), covs.end() );
+        }
+
+        m_vSeries.push_back( vRow );
+        m_iSamples++;
+    }
+}
+
+long Apothesis::mf_getNumEventHappened( Process* proc )
+{
+    return m_pParallel ? m_pParallel->getNumEventHappened( proc->getID() ) : proc->getNumEventHappened();
+}
+
+int Apothesis::mf_getClassSize( Process* proc )
+{
+    return m_pParallel ? m_pParallel->getClassSize( proc->getID() ) : mf_classSize( proc->getID() );
+}
+
+void Apothesis::mf_writeCheckpoint()
+{
+    string file = pIO->getOutputPath() + "Checkpoint.bin";
+    Engine::CheckpointWriter checkpoint( file );
+
+    //The simulation that the checkpoint belongs to
+    checkpoint.write( pLattice->getX() );
+    checkpoint.write( pLattice->getY() );
+    checkpoint.write( pLattice->getSize() );
+    checkpoint.write( (int)pLattice->getOrdering() );
+    checkpoint.write( (int)m_vProcesses.size() );
+    for ( Process* p:m_vProcesses )
+        checkpoint.write( p->getName() );
+    checkpoint.write( m_pSelector->getName() );
+    checkpoint.write( m_pScheduler != 0 );
+
+    //The time (with the time step already drawn for the next event), the counters and the output
+    checkpoint.write( m_dProcTime );
+    checkpoint.write( m_dt );
+    checkpoint.write( m_dRTot );
+    checkpoint.write( m_iEvents );
+    checkpoint.write( m_dMaxDrift );
+    checkpoint.write( m_iEvaluatedRules );
+    checkpoint.write( m_iSkippedRules );
+    checkpoint.write( m_dTimeToWriteLog );
+    checkpoint.write( m_dTimeToWriteLattice );
+    checkpoint.write( m_dMeanDHPrevStep );
+    checkpoint.write( m_dPrevTimeStep );
+    checkpoint.write( m_dTimeToCheckpoint );
+    checkpoint.write( pIO->getOutputSize() );
+
+    checkpoint.write( m_iSamples );
+    checkpoint.write( (int)m_vSeries.size() );
+    for ( const vector<double>& row:m_vSeries )
+        checkpoint.write( row );
+
+    //The names of the species so that the IDs of the sites can be mapped to the species of the restarted run
+    SpeciesRegistry& species = pParameters->getSpeciesRegistry();
+    checkpoint.write( species.size() );
+    for ( int i = 0; i < species.size(); i++ )
+        checkpoint.write( species.getName( i ) );
+
+    //The state of every site
+    for ( Site* s:pLattice->getSites() ){
+        checkpoint.write( s->getHeight() );
+        checkpoint.write( s->getNeighsNum() );
+        checkpoint.write( s->isOccupied() );
+        checkpoint.write( s->getSpecies() );
+        checkpoint.write( s->getBelowSpecies() );
+        checkpoint.write( s->getCoupledSite() ? s->getCoupledSite()->getID() : -1 );
+    }
+
+    //The classes keep the order of their sites (the bonds for the pair processes) as it decides which site is picked
+    for ( Process* p:m_vProcesses ){
+        vector<int> vSites;
+        if ( p->isPairProcess() )
+            for ( const Engine::Bond& bond:m_vBondClasses[ p->getID() ]->getBonds() )
+                vSites.push_back( bond.iID );
+        else
+            for ( Site* s:m_vClasses[ p->getID() ]->getSites() )
+                vSites.push_back( s->getID() );
+
+        checkpoint.write( p->getNumEventHappened() );
+        checkpoint.write( vSites );
+    }
+
+    m_pSelector->save( checkpoint );
+    if ( m_pScheduler )
+        m_pScheduler->save( checkpoint );
+
+    checkpoint.write( m_pScaling != 0 );
+    if ( m_pScaling )
+        m_pScaling->save( checkpoint );
+
+    pRandomGen->save( checkpoint );
+
+    //The run goes on even if the checkpoint could not be written (the previous one is kept)
+    if ( !checkpoint.commit() )
+        pErrorHandler->warningSimple_msg( "Could not write the checkpoint " + file );
+}
+
+long Apothesis::mf_readCheckpoint( string file )
+{
+    Engine::CheckpointReader checkpoint( file );
+    if ( !checkpoint.good() ){
+        pErrorHandler->error_simple_msg("Could not read the checkpoint " + file + ". Is it a checkpoint of this version of apothesis?");
+        EXIT
+    }
+
+    //It must be a checkpoint of the same simulation
+    int iX = 0, iY = 0, iSize = 0, iOrdering = 0, iProcesses = 0;
+    string selection;
+    bool bScheduler = false;
+
+    checkpoint.read( iX );
+    checkpoint.read( iY );
+    checkpoint.read( iSize );
+    checkpoint.read( iOrdering );
+    checkpoint.read( iProcesses );
+
+    //The state of the sites is stored by their IDs so the order of the sites must be the same
+    bool bSame = iX == pLattice->getX() && iY == pLattice->getY() && iSize == pLattice->getSize() && iOrdering == (int)pLattice->getOrdering()
+            && iProcesses == (int)m_vProcesses.size();
+    for ( int i = 0; bSame && i < iProcesses; i++ ){
+        string name;
+        checkpoint.read( name );
+        bSame = name == m_vProcesses[ i ]->getName();
+    }
+
+    checkpoint.read( selection );
+    checkpoint.read( bScheduler );
+
+    if ( !checkpoint.good() || !bSame || selection != m_pSelector->getName() || bScheduler != ( m_pScheduler != 0 ) ){
+        pErrorHandler->error_simple_msg("The checkpoint " + file + " was not written by this simulation (the lattice, the processes, the selection or the scheduler are different).");
+        EXIT
+    }
+
+    long iOutputSize = 0;
+    int iRows = 0;
+
+    checkpoint.read( m_dProcTime );
+    checkpoint.read( m_dt );
+    checkpoint.read( m_dRTot );
+    checkpoint.read( m_iEvents );
+    checkpoint.read( m_dMaxDrift );
+    checkpoint.read( m_iEvaluatedRules );
+    checkpoint.read( m_iSkippedRules );
+    checkpoint.read( m_dTimeToWriteLog );
+    checkpoint.read( m_dTimeToWriteLattice );
+    checkpoint.read( m_dMeanDHPrevStep );
+    checkpoint.read( m_dPrevTimeStep );
+    checkpoint.read( m_dTimeToCheckpoint );
+    checkpoint.read( iOutputSize );
+
+    checkpoint.read( m_iSamples );
+    checkpoint.read( iRows );
+    m_vSeries.assign( checkpoint.good() ? iRows : 0, vector<double>() );
+    for ( vector<double>& row:m_vSeries )
+        checkpoint.read( row );
+
+    //The species of the checkpoint are registered (if they are not) and mapped to their IDs in this run
+    int iSpecies = 0;
+    checkpoint.read( iSpecies );
+    vector<int> vSpecies;
+    for ( int i = 0; i < iSpecies && checkpoint.good(); i++ ){
+        string name;
+        checkpoint.read( name );
+        vSpecies.push_back( pParameters->getSpeciesRegistry().add( name ) );
+    }
+
+    for ( Site* s:pLattice->getSites() ){
+        int iHeight = 0, iNeighs = 0, iCoupled = -1, iLabel = 0, iBelowLabel = 0;
+        bool bOccupied = false;
+
+        checkpoint.read( iHeight );
+        checkpoint.read( iNeighs );
+        checkpoint.read( bOccupied );
+        checkpoint.read( iLabel );
+        checkpoint.read( iBelowLabel );
+        checkpoint.read( iCoupled );
+
+        //A truncated checkpoint is reported below
+        if ( !checkpoint.good() )
+            break;
+
+        if ( iLabel < 0 || iLabel >= (int)vSpecies.size() || iBelowLabel < 0 || iBelowLabel >= (int)vSpecies.size() ){
+            pErrorHandler->error_simple_msg( "The checkpoint " + file + " has a site with an unknown species." );
+            EXIT
+        }
+
+        s->setHeight( iHeight );
+        s->setNeighsNum( iNeighs );
+        s->setOccupied( bOccupied );
+        s->setSpecies( vSpecies[ iLabel ] );
+        s->setBelowSpecies( vSpecies[ iBelowLabel ] );
+
+        if ( iCoupled >= 0 && iCoupled < iSize )
+            s->setCoupledSite( pLattice->getSite( iCoupled ) );
+        else
+            s->removeCouple();
+    }
+
+    pLattice->computeSurfaceSums();
+    pLattice->computeSpeciesCounts();
+
+    for ( Process* p:m_vProcesses ){
+        long iHappened = 0;
+        vector<int> vSites;
+
+        checkpoint.read( iHappened );
+        checkpoint.read( vSites );
+
+        p->setNumEventHappened( iHappened );
+
+        if ( p->isPairProcess() ){
+            Engine::BondClass& bondClass = *m_vBondClasses[ p->getID() ];
+            bondClass.clear();
+            for ( int id:vSites )
+                if ( id >= 0 && id < pLattice->getNumBonds() )
+                    bondClass.insert( id, pLattice->getBondSite( id ), pLattice->getBondNeighbour( id ) );
+            continue;
+        }
+
+        Engine::SiteClass& procClass = *m_vClasses[ p->getID() ];
+        procClass.clear();
+        for ( int id:vSites )
+            if ( id >= 0 && id < iSize )
+                procClass.insert( pLattice->getSite( id ) );
+    }
+
+    mf_buildClassMasks();
+
+    m_pSelector->load( checkpoint );
+    if ( m_pScheduler )
+        m_pScheduler->load( checkpoint );
+
+    bool bScaling = false;
+    checkpoint.read( bScaling );
+    if ( bScaling != ( m_pScaling != 0 ) ){
+        pErrorHandler->error_simple_msg("The checkpoint " + file + " was not written by this simulation (the acceleration is different).");
+        EXIT
+    }
+
+    if ( m_pScaling )
+        m_pScaling->load( checkpoint );
+
+    pRandomGen->load( checkpoint );
+
+    if ( !checkpoint.good() ){
+        pErrorHandler->error_simple_msg("The checkpoint " + file + " is incomplete.");
+        EXIT
+    }
+
+    return iOutputSize;
 }
 
 void Apothesis::logSuccessfulRead(bool read, string parameter)
@@ -25,17 +25,30 @@
 #include <functional>
 #include <set>
 #include <valarray>
-
-#define EXIT { printf("Apothesis terminated. \n"); exit( EXIT_FAILURE ); }
+#include <stdexcept>
+#include <chrono>
+#include <cstdint>
 
 using namespace std;
 
+/** An error that stops an instance of apothesis (the error handler has already reported it).
+ * It is thrown instead of terminating the program so that each instance fails on its own
+ * and its caller (e.g. main or an ensemble) decides what to do. */
+class ApothesisError: public runtime_error
+{
+public:
+    ApothesisError( const string& msg ):runtime_error( msg ){}
+};
+
+#define EXIT { throw ApothesisError( "Apothesis terminated." ); }
+
 /** The basic class of the kinetic monte carlo code. */
 
 namespace Utils{ class ErrorHandler; class Parameters; class Properties; }
 namespace SurfaceTiles{ class Site; }
 namespace MicroProcesses { class Process; class Adsorption; class Desorption; class Diffusion; class SurfaceReaction; }
 namespace RandomGen { class RandomGenerator; }
+namespace Engine { class Selector; class SiteClass; class BondClass; class NextReactionScheduler; class SynchronousSublattice; class RateScaling; }
 
 class Lattice;
 class IO;
@@ -44,7 +57,8 @@ class Reader;
 class Apothesis
 {
 public:
-    Apothesis( int argc, char* argv[] );
+    /// Every instance is self-contained. Its output files are written in the given path (the working directory if empty).
+    Apothesis( int argc, char* argv[], string outputPath = "" );
     virtual ~Apothesis();
 
     /// Pointers to the classes that will share the common space i.e. the "pointer"
@@ -73,6 +87,27 @@ public:
     /// as these are written in the input file are constcucted through the factory method
     void init();
 
+    /// Reads the input file (only once). It is called by init() if it has not been called before.
+    void readInput();
+
+    /// Builds the lattice, creates the processes and partitions the sites in their classes (only once).
+    /// It is called by init() if it has not been called before. If a base instance already built from the same input
+    /// is given, its lattice and its partition are copied instead of built (the processes are created so that their rate
+    /// constants are computed from the parameters of this instance). The base is only read.
+    void build( Apothesis* base = 0 );
+
+    /// Overrides the random generator initializer of the input file (0 keeps the one of the input file).
+    inline void setRandomSeed( int seed ){ m_iSeed = seed; }
+
+    /// Records the time series of the run in memory, sampled every time step of the log.
+    inline void setRecording( bool record ){ m_bRecord = record; }
+
+    /// Returns the names of the recorded quantities. The first one is the time.
+    inline const vector<string>& getSeriesColumns(){ return m_vsSeriesColumns; }
+
+    /// Returns the recorded time series (one row for each sampling time, ordered as the columns).
+    inline const vector< vector<double> >& getSeries(){ return m_vSeries; }
+
     /// Perform the KMC iteratios
     void exec();
 
@@ -93,7 +128,32 @@ public:
 
 private:
     /// The process map which holds all the processes and the sites that each can be performed.
-    unordered_map< MicroProcesses::Process*, set< SurfaceTiles::Site* > > m_processMap;
+    unordered_map< MicroProcesses::Process*, Engine::SiteClass > m_processMap;
+
+    /// The processes ordered by their ID (i.e. the order in which they are visited by the selection).
+    /// The IDs follow the names of the processes so that every instance built from the same input visits them in the same order.
+    vector< MicroProcesses::Process* > m_vProcesses;
+
+    /// The class of each process ordered by the ID of the process (they point in m_processMap).
+    vector< Engine::SiteClass* > m_vClasses;
+
+    /// The class of the bonds of each pair process ordered by the ID of the process (null for the processes performed on a site).
+    vector< Engine::BondClass* > m_vBondClasses;
+
+    /// Selects the process class of the next event according to the rates of the classes.
+    Engine::Selector* m_pSelector;
+
+    /// Schedules the events by their firing times if the next reaction method is used (null for the direct method).
+    Engine::NextReactionScheduler* m_pScheduler;
+
+    /// Performs the events in parallel domains if the synchronous sublattice method is used (null for a serial run).
+    Engine::SynchronousSublattice* m_pParallel;
+
+    /// Scales the rates of the quasi-equilibrated fast processes if the run is accelerated (null otherwise).
+    Engine::RateScaling* m_pScaling;
+
+    /// The equation of the input that created each process ordered by the ID of the process.
+    vector<string> m_vsEquations;
 
     /// The number of flags given by the user
     int m_iArgc;
@@ -110,7 +170,115 @@ private:
     /// Analyzes the process and returns its type: Adsorption, Desorption, Diffusion or Reaction
     string mf_analyzeProc(string);
 
+    /// Sets in every site the mask of the classes it belongs to (from the classes).
+    void mf_buildClassMasks();
+
+    /// Returns the bit of the process in the masks of the classes.
+    inline uint64_t mf_bit( MicroProcesses::Process* proc );
+
+    /// Returns the number of events (sites or bonds) in the class of the process with the given ID.
+    int mf_classSize( int process );
+
+    /// Tests the pair process in the bonds from the site to its neighbours and updates its class.
+    /// Returns true if the class changed.
+    bool mf_testBonds( MicroProcesses::Process* proc, SurfaceTiles::Site* s, double time );
+
+    /// Returns the factor that scales the rate of the process (1 if the run is not accelerated).
+    inline double mf_factor( MicroProcesses::Process* proc );
+
+    /// Returns the (scaled) rate constant of the process.
+    inline double mf_rate( MicroProcesses::Process* proc );
+
+    /// Groups the processes in channels by their equations and pairs every channel with its reverse for the acceleration.
+    void mf_initScaling();
+
+    /// Ends a stage of the acceleration and updates the rates of the processes if their factors changed.
+    void mf_endStage( double time );
+
+    /// Updates the classes of the processes in the sites affected by a perform and their rates
+    /// (in the selection and for the next reaction method in the schedule at the given time) from the attributes written
+    /// and the sites modified and affected.
+    void mf_update( int writes, const set<SurfaceTiles::Site*>& modified, const set<SurfaceTiles::Site*>& affected, double time );
+
+    /// Recomputes the rate of each class and the total rate (R_tot) exactly.
+    /// Returns the drift of the running R_tot before the recomputation.
+    double mf_resumRates();
+
+    /// Returns how many times the process happened (in all the domains for a parallel run).
+    long mf_getNumEventHappened( MicroProcesses::Process* proc );
+
+    /// Returns the number of sites where the process can be performed (in all the domains for a parallel run).
+    int mf_getClassSize( MicroProcesses::Process* proc );
+
+    /// Appends to the time series the state for every sampling time before the given time
+    void mf_record( double time );
+
+    /// Writes the state of the run in the checkpoint file of its output path.
+    void mf_writeCheckpoint();
+
+    /// Restores the state of the run from a checkpoint and returns the size of the output file when it was written.
+    long mf_readCheckpoint( string file );
+
+    /// True if the run continues from a checkpoint
+    bool m_bRestarted;
+
+    /// The signals for writing a checkpoint (and for stopping after writing it) that this run has handled
+    int m_iCheckpointSignals;
+    int m_iStopSignals;
+
+    /// The simulated time since the last checkpoint
+    double m_dTimeToCheckpoint;
+
+    /// The wall clock time of the last checkpoint
+    chrono::steady_clock::time_point m_tLastCheckpoint;
+
+    /// The simulated time since the log and the lattice were written
+    double m_dTimeToWriteLog;
+    double m_dTimeToWriteLattice;
+
+    /// The mean height and the time when the log was written (for the growth rate)
+    double m_dMeanDHPrevStep;
+    double m_dPrevTimeStep;
+
+    /// True if the input file has been read
+    bool m_bInputRead;
+
+    /// True if the lattice and the classes have been built
+    bool m_bBuilt;
+
+    /// The random generator initializer given by the caller (0 if it is read from the input file)
+    int m_iSeed;
+
+    /// True if the time series is recorded
+    bool m_bRecord;
+
+    /// The number of samples recorded
+    long m_iSamples;
+
+    /// The names of the recorded quantities
+    vector<string> m_vsSeriesColumns;
+
+    /// The recorded time series
+    vector< vector<double> > m_vSeries;
+
+    /// The total rate. It is kept as a running sum by the selection and it is resummed exactly every m_iResumEvery events.
     double m_dRTot;
+
+    /// The number of events performed
+    long m_iEvents;
+
+    /// Every how many events the total rate is resummed exactly
+    long m_iResumEvery;
+
+    /// The maximum relative drift of the running total rate found in the resummations
+    double m_dMaxDrift;
+
+    /// The number of (site, process) rules evaluated after the performs
+    long m_iEvaluatedRules;
+
+    /// The number of (site, process) rules skipped because the perform did not write anything they read
+    long m_iSkippedRules;
+
     double m_dEndTime;
     double m_dProcTime;
     double m_dProcRate;
@@ -0,0 +1,81 @@
+#!/bin/bash
+
+# Validates the coarse-grained lattice against the lattice of sites on the adsorption, desorption and diffusion of CO
+# (without growth, under the next reaction method). A run for every cell edge ("fine" is the simple cubic lattice of sites)
+# uses the same input and the first run is the reference. The wall time, the events, the memory per site of the surface
+# and the coverage at the end time are reported, followed by the largest difference of the coverage from the reference
+# over the log (every log time of the reference is compared with the closest log time of the run).
+# The reference may be a coarse-grained run too, e.g. for surfaces too large for the lattice of sites (10^8 sites below).
+#
+# Usage: ./benchmark_coarse.sh <Apothesis executable> [lattice size] [end time] [seed] [cell edges]
+# e.g.   ./benchmark_coarse.sh ../build/Apothesis 400 0.002 12345 "fine 5 10 20"
+#        ./benchmark_coarse.sh ../build/Apothesis 10000 0.000001 12345 "10 100"
+
+if [ -z "$1" ]; then
+    echo "Usage: $0 <Apothesis executable> [lattice size] [end time] [seed] [cell edges]"
+    exit 1
+fi
+
+EXE=$(readlink -f "$1")
+SIZE=${2:-400}
+TIME=${3:-0.002}
+SEED=${4:-12345}
+EDGES=${5:-"fine 5 10 20"}
+
+# The coverage columns of the log: the time and the coverages of every row
+coverages() {
+    awk -F'\t' '/^Time \(s\)/{ for ( i = 1; i <= NF; i++ ) if ( $i ~ /\(coverage\)/ ) c[ ++n ] = i; on = 1; next }
+                on && NF > 1 { printf "%s", $1; for ( i = 1; i <= n; i++ ) printf " %s", $c[ i ]; printf "\n" }
+                on && NF <= 1 { exit }' "$1"
+}
+
+REFERENCE=""
+
+printf "%-10s %12s %12s %14s %18s   %s\n" "run" "wall (s)" "events" "events/s" "bytes per site" "coverage at the end (max difference)"
+
+for EDGE in $EDGES; do
+    DIR=$(mktemp -d)
+
+    if [ "$EDGE" == "fine" ]; then
+        echo "lattice: SimpleCubic $SIZE $SIZE 10 Pt" > "$DIR/input.kmc"
+        CELL=1
+    else
+        echo "lattice: CoarseGrained $SIZE $SIZE 10 Pt $EDGE" > "$DIR/input.kmc"
+        CELL=$(( EDGE*EDGE ))
+    fi
+
+    cat >> "$DIR/input.kmc" <<EOT
+time: $TIME
+temperature: 500
+pressure: 101325
+CO + * -> CO*: constant 2000
+CO* -> CO + *: constant 1000
+CO* -> CO*: arrhenius 1e13 50000 36000
+scheduler: nrm
+random: $SEED
+write: log $( awk -v t="$TIME" 'BEGIN{ print t/20 }' )
+write: lattice $TIME
+report: coverage CO*
+EOT
+
+    START=$(date +%s.%N)
+    ( cd "$DIR" && "$EXE" > /dev/null 2>&1 )
+    END=$(date +%s.%N)
+
+    EVENTS=$(awk '/^Events/{ print $2 }' "$DIR/Output.log")
+    MEMORY=$(awk -v q="$CELL" '/^Memory per site/{ print $4/q }' "$DIR/Output.log")
+    coverages "$DIR/Output.log" > "$DIR/coverages.txt"
+
+    [ -z "$REFERENCE" ] && REFERENCE=$DIR
+    DIFF=$(awk 'NR == FNR{ t[ NR ] = $1; for ( i = 2; i <= NF; i++ ) c[ NR, i ] = $i; n = NR; next }
+                { best = 1; for ( j = 1; j <= n; j++ ) if ( ( t[ j ] - $1 )^2 < ( t[ best ] - $1 )^2 ) best = j;
+                  for ( i = 2; i <= NF; i++ ){ d = c[ best, i ] - $i; if ( d < 0 ) d = -d; if ( d > m ) m = d } }
+                END{ printf "%.4f", m }' "$DIR/coverages.txt" "$REFERENCE/coverages.txt")
+
+    awk -v r="$EDGE" -v s="$START" -v e="$END" -v n="$EVENTS" -v m="$MEMORY" -v c="$(tail -1 "$DIR/coverages.txt" | cut -d' ' -f2-)" -v d="$DIFF" \
+        'BEGIN{ printf "%-10s %12.3f %12d %14.0f %18.3f   %s (%s)\n", r, e - s, n, n/(e - s), m, c, d }'
+
+    [ "$DIR" != "$REFERENCE" ] && rm -rf "$DIR"
+done
+
+rm -rf "$REFERENCE"
@@ -0,0 +1,65 @@
+#!/bin/bash
+
+# Cache behaviour of the event loop for the orders of the sites in memory (row-major and morton) on input.kmc.
+# Every order is run up to the end time and up to time 0; the second run (reading the input, building the lattice and
+# the classes) is subtracted so that only the event loop is measured. The lattice, the end time and the random init num
+# are the same for both orders. The sites are visited in a different order, so the runs are statistically but not
+# event by event the same: compare the time and (if perf is available) the cache misses per event.
+#
+# Usage: ./benchmark_ordering.sh <Apothesis executable> [lattice size] [end time]
+# e.g.   ./benchmark_ordering.sh ../build/Apothesis 2000 0.2
+
+if [ -z "$1" ]; then
+    echo "Usage: $0 <Apothesis executable> [lattice size] [end time]"
+    exit 1
+fi
+
+EXE=$(readlink -f "$1")
+SIZE=${2:-2000}
+TIME=${3:-0.2}
+INPUT=$(dirname "$(readlink -f "$0")")/input.kmc
+
+PERF=""
+if command -v perf > /dev/null 2>&1 && perf stat -e cache-misses true > /dev/null 2>&1; then
+    PERF="perf stat -x, -e cache-misses,L1-dcache-load-misses -o perf.txt"
+fi
+
+DIR=$(mktemp -d)
+
+# Runs the given order up to the given time and sets WALL, EVENTS, LLC and L1
+run() {
+    sed -e "s/^lattice:.*/lattice: SimpleCubic $SIZE $SIZE 10 A/" \
+        -e "s/^time:.*/time: $2/" \
+        -e "/^random:/d" \
+        -e "/^ordering:/d" \
+        -e "s/^write: log.*/write: log $TIME/" \
+        -e "s/^write: lattice.*/write: lattice $TIME/" "$INPUT" > "$DIR/input.kmc"
+    echo "random: 12345" >> "$DIR/input.kmc"
+    echo "ordering: $1" >> "$DIR/input.kmc"
+    rm -f "$DIR/perf.txt"
+
+    local START=$(date +%s.%N)
+    ( cd "$DIR" && $PERF "$EXE" > /dev/null 2>&1 )
+    local END=$(date +%s.%N)
+
+    WALL=$(awk -v s="$START" -v e="$END" 'BEGIN{ print e - s }')
+    EVENTS=$(awk '/^Events/{ print $2 }' "$DIR/Output.log")
+    LLC=$(awk -F, '/cache-misses/{ print $1 }' "$DIR/perf.txt" 2> /dev/null)
+    L1=$(awk -F, '/L1-dcache-load-misses/{ print $1 }' "$DIR/perf.txt" 2> /dev/null)
+}
+
+printf "%-10s %12s %12s %14s %16s %16s\n" "ordering" "loop (s)" "events" "events/s" "LLC miss/event" "L1 miss/event"
+
+for ORDER in row-major morton; do
+    run $ORDER 0
+    WALL0=$WALL; LLC0=$LLC; L10=$L1
+
+    run $ORDER $TIME
+
+    awk -v o="$ORDER" -v w="$WALL" -v w0="$WALL0" -v ev="$EVENTS" -v llc="$LLC" -v llc0="$LLC0" -v l1="$L1" -v l10="$L10" \
+        'BEGIN{ w -= w0;
+                printf "%-10s %12.3f %12d %14.0f %16s %16s\n", o, w, ev, ev/w,
+                       ( llc == "" ? "n/a" : sprintf( "%.2f", ( llc - llc0 )/ev ) ), ( l1 == "" ? "n/a" : sprintf( "%.2f", ( l1 - l10 )/ev ) ) }'
+done
+
+rm -rf "$DIR"
@@ -0,0 +1,51 @@
+#!/bin/bash
+
+# Strong scaling of the parallel (synchronous sublattice) run on input.kmc.
+# The lattice, the number of domains and the time window are fixed and only the number of
+# OpenMP threads changes, so every run performs exactly the same events.
+# The wall time, the speedup and the parallel efficiency over one thread are reported.
+#
+# Usage: ./benchmark_parallel.sh <Apothesis executable> [lattice size] [domains] [window] [end time] [threads]
+# e.g.   ./benchmark_parallel.sh ../build/Apothesis 1000 16 0.01 0.5 "1 2 4 8"
+
+if [ -z "$1" ]; then
+    echo "Usage: $0 <Apothesis executable> [lattice size] [domains] [window] [end time] [threads]"
+    exit 1
+fi
+
+EXE=$(readlink -f "$1")
+SIZE=${2:-1000}
+DOMAINS=${3:-16}
+WINDOW=${4:-0.01}
+TIME=${5:-0.5}
+THREADS=${6:-"1 2 4 $(nproc)"}
+INPUT=$(dirname "$(readlink -f "$0")")/input.kmc
+
+DIR=$(mktemp -d)
+sed -e "s/^lattice:.*/lattice: SimpleCubic $SIZE $SIZE 10 A/" \
+    -e "s/^time:.*/time: $TIME/" \
+    -e "/^random:/d" \
+    -e "/^parallel:/d" \
+    -e "s/^write: log.*/write: log $TIME/" \
+    -e "s/^write: lattice.*/write: lattice $TIME/" "$INPUT" > "$DIR/input.kmc"
+echo "random: 12345" >> "$DIR/input.kmc"
+echo "parallel: $DOMAINS $WINDOW" >> "$DIR/input.kmc"
+
+printf "%-8s %12s %12s %10s %12s\n" "threads" "wall (s)" "events" "speedup" "efficiency"
+
+for N in $THREADS; do
+    START=$(date +%s.%N)
+    ( cd "$DIR" && OMP_NUM_THREADS=$N "$EXE" > /dev/null 2>&1 )
+    END=$(date +%s.%N)
+
+    EVENTS=$(awk '/^Events/{ print $2 }' "$DIR/Output.log")
+    WALL=$(awk -v s="$START" -v e="$END" 'BEGIN{ print e - s }')
+    if [ -z "$WALL1" ]; then
+        WALL1=$WALL
+    fi
+
+    awk -v n="$N" -v w="$WALL" -v w1="$WALL1" -v ev="$EVENTS" \
+        'BEGIN{ printf "%-8d %12.3f %12d %10.2f %12.2f\n", n, w, ev, w1/w, w1/(w*n) }'
+done
+
+rm -rf "$DIR"
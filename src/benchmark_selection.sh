@@ -0,0 +1,42 @@
+#!/bin/bash
+
+# Compares the event selection methods on input.kmc.
+# Every method runs the same input (end time, seed and lattice output are overwritten) and
+# the wall time, the number of events and the events per second are reported.
+#
+# Usage: ./benchmark_selection.sh <Apothesis executable> [end time] [seed] [methods]
+# e.g.   ./benchmark_selection.sh ../build/Apothesis 5 12345 "linear tree composition"
+
+if [ -z "$1" ]; then
+    echo "Usage: $0 <Apothesis executable> [end time] [seed] [methods]"
+    exit 1
+fi
+
+EXE=$(readlink -f "$1")
+TIME=${2:-5}
+SEED=${3:-12345}
+METHODS=${4:-"linear tree composition"}
+INPUT=$(dirname "$(readlink -f "$0")")/input.kmc
+
+printf "%-12s %12s %12s %14s\n" "selection" "wall (s)" "events" "events/s"
+
+for METHOD in $METHODS; do
+    DIR=$(mktemp -d)
+
+    sed -e "s/^time:.*/time: $TIME/" \
+        -e "/^random:/d" \
+        -e "/^selection:/d" \
+        -e "s/^write: lattice.*/write: lattice $TIME/" "$INPUT" > "$DIR/input.kmc"
+    echo "random: $SEED" >> "$DIR/input.kmc"
+    echo "selection: $METHOD" >> "$DIR/input.kmc"
+
+    START=$(date +%s.%N)
+    ( cd "$DIR" && "$EXE" > /dev/null 2>&1 )
+    END=$(date +%s.%N)
+
+    EVENTS=$(awk '/^Events/{ print $2 }' "$DIR/Output.log")
+    awk -v m="$METHOD" -v s="$START" -v e="$END" -v n="$EVENTS" \
+        'BEGIN{ printf "%-12s %12.3f %12d %14.0f\n", m, e - s, n, n/(e - s) }'
+
+    rm -rf "$DIR"
+done
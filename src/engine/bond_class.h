@@ -0,0 +1,116 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef BOND_CLASS_H
+#define BOND_CLASS_H
+
+#include <vector>
+
+#include "site.h"
+
+using namespace std;
+using namespace SurfaceTiles;
+
+namespace Engine
+{
+
+/// A bond between a site and one of its neighbours i.e. an event of a process performed on a pair of sites.
+struct Bond
+{
+    /// The ID of the bond (see NeighbourTable)
+    int iID;
+
+    /// The site that the bond starts from and its neighbour
+    Site* pSite;
+    Site* pNeighbour;
+};
+
+/** The class of the bonds where a pair process (e.g. A* + B* -> AB*) can be performed.
+ * It is the SiteClass of the bonds: the bonds are stored densely in a vector and the position of each bond in the vector
+ * is indexed by the ID of the bond, so insertion, removal, membership test and uniform random pick are O(1).
+ * A class that holds only the bonds of a part of the lattice (e.g. a domain in parallel runs) can be given an index
+ * which maps the ID of each bond to its position in that part. */
+class BondClass
+{
+public:
+    /// Constructor for a lattice with the given number of bonds.
+    /// If an index is given, the bonds are indexed with index[ ID ] which must be in [0, bonds).
+    BondClass( int bonds = 0, const vector<int>* index = 0 );
+
+    virtual ~BondClass();
+
+    /// Adds the bond from the site to the neighbour with the given ID in the class (if it is not already there).
+    inline void insert( int id, Site* s, Site* neigh ){
+        int iIndex = mf_index( id );
+        if ( m_vPos[ iIndex ] != -1 )
+            return;
+
+        m_vPos[ iIndex ] = m_vBonds.size();
+        m_vBonds.push_back( Bond{ id, s, neigh } );
+    }
+
+    /// Removes the bond with the given ID from the class (if it is there).
+    inline void erase( int id ){
+        int iIndex = mf_index( id );
+        int iPos = m_vPos[ iIndex ];
+        if ( iPos == -1 )
+            return;
+
+        m_vBonds[ iPos ] = m_vBonds.back();
+        m_vPos[ mf_index( m_vBonds[ iPos ].iID ) ] = iPos;
+
+        m_vBonds.pop_back();
+        m_vPos[ iIndex ] = -1;
+    }
+
+    /// Removes all the bonds from the class.
+    inline void clear(){
+        for ( const Bond& bond:m_vBonds )
+            m_vPos[ mf_index( bond.iID ) ] = -1;
+
+        m_vBonds.clear();
+    }
+
+    /// Returns true if the bond with the given ID is in the class.
+    inline bool contains( int id ) const { return m_vPos[ mf_index( id ) ] != -1; }
+
+    /// Returns the number of bonds in the class.
+    inline int size() const { return m_vBonds.size(); }
+
+    /// Returns the bond in the given position of the class [0, size()).
+    inline const Bond& getBond( int pos ) const { return m_vBonds[ pos ]; }
+
+    /// Returns the bonds of the class.
+    inline const vector<Bond>& getBonds() const { return m_vBonds; }
+
+private:
+    /// Returns the position of the bond in m_vPos
+    inline int mf_index( int id ) const { return m_pIndex ? (*m_pIndex)[ id ] : id; }
+
+    /// The bonds of the class.
+    vector<Bond> m_vBonds;
+
+    /// The position of each bond in m_vBonds (-1 if the bond is not in the class). Indexed by the bond ID.
+    vector<int> m_vPos;
+
+    /// Maps the ID of a bond to its position in m_vPos (null if the ID is used directly). Not owned.
+    const vector<int>* m_pIndex;
+};
+
+}
+
+#endif // BOND_CLASS_H
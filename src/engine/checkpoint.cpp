@@ -0,0 +1,93 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "checkpoint.h"
+
+#include <cstdio>
+
+namespace Engine
+{
+
+/// Identifies the checkpoint files and the version of their layout. It must change every time the layout changes.
+static const string sMagic = "APOTHESIS-CHECKPOINT";
+static const uint32_t iVersion = 7;
+
+CheckpointWriter::CheckpointWriter( string file ):m_sFile( file ), m_sTemporary( file + ".tmp" )
+{
+    m_File.open( m_sTemporary, ios::out | ios::binary | ios::trunc );
+
+    m_File.write( sMagic.data(), sMagic.size() );
+    write( iVersion );
+}
+
+CheckpointWriter::~CheckpointWriter(){}
+
+void CheckpointWriter::write( const string& value )
+{
+    write( (uint64_t)value.size() );
+    m_File.write( value.data(), value.size() );
+}
+
+bool CheckpointWriter::commit()
+{
+    m_File.close();
+    if ( m_File.fail() )
+        return false;
+
+    return rename( m_sTemporary.c_str(), m_sFile.c_str() ) == 0;
+}
+
+CheckpointReader::CheckpointReader( string file )
+{
+    m_File.open( file, ios::in | ios::binary );
+
+    string sMagicRead( sMagic.size(), ' ' );
+    m_File.read( &sMagicRead[ 0 ], sMagic.size() );
+
+    uint32_t iVersionRead = 0;
+    read( iVersionRead );
+
+    if ( sMagicRead != sMagic || iVersionRead != iVersion )
+        m_File.setstate( ios::failbit );
+}
+
+CheckpointReader::~CheckpointReader(){}
+
+void CheckpointReader::read( string& value )
+{
+    uint64_t iSize = 0;
+    read( iSize );
+    if ( !good() || iSize > mf_remaining() ){
+        m_File.setstate( ios::failbit );
+        return;
+    }
+
+    value.resize( iSize );
+    m_File.read( &value[ 0 ], iSize );
+}
+
+uint64_t CheckpointReader::mf_remaining()
+{
+    streampos current = m_File.tellg();
+    m_File.seekg( 0, ios::end );
+    streampos end = m_File.tellg();
+    m_File.seekg( current );
+
+    return end - current;
+}
+
+}
@@ -0,0 +1,118 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <type_traits>
+
+using namespace std;
+
+namespace Engine
+{
+
+/** Writes the state of a simulation in a binary checkpoint file.
+ * The values are written as they are in memory (the file is read back by the same build on the same machine).
+ * The file is written in a temporary file which replaces the checkpoint only when commit() is called,
+ * so a run that is killed while writing does not leave a broken checkpoint behind. */
+class CheckpointWriter
+{
+public:
+    /// Opens the temporary file of the given checkpoint and writes the header.
+    CheckpointWriter( string file );
+    virtual ~CheckpointWriter();
+
+    /// Writes a value of a plain type (numbers, booleans and structs of them).
+    template <typename T> void write( const T& value ){
+        static_assert( is_trivially_copyable<T>::value, "Only plain types can be written directly." );
+        m_File.write( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+    }
+
+    /// Writes a string (its length and its characters).
+    void write( const string& value );
+
+    /// Writes a vector of plain values (its size and its values).
+    template <typename T> void write( const vector<T>& values ){
+        static_assert( is_trivially_copyable<T>::value, "Only vectors of plain types can be written directly." );
+        write( (uint64_t)values.size() );
+        m_File.write( reinterpret_cast<const char*>( values.data() ), values.size()*sizeof( T ) );
+    }
+
+    /// Closes the temporary file and moves it to the checkpoint. Returns false if anything could not be written.
+    bool commit();
+
+private:
+    /// The checkpoint file
+    string m_sFile;
+
+    /// The temporary file
+    string m_sTemporary;
+
+    /// The stream of the temporary file
+    ofstream m_File;
+};
+
+/** Reads the state of a simulation from a checkpoint written by the CheckpointWriter.
+ * Reading past the end of the file or a file of another format sets the reader to a failed state (see good()). */
+class CheckpointReader
+{
+public:
+    /// Opens the checkpoint and reads its header.
+    CheckpointReader( string file );
+    virtual ~CheckpointReader();
+
+    /// Reads a value of a plain type.
+    template <typename T> void read( T& value ){
+        static_assert( is_trivially_copyable<T>::value, "Only plain types can be read directly." );
+        m_File.read( reinterpret_cast<char*>( &value ), sizeof( T ) );
+    }
+
+    /// Reads a string.
+    void read( string& value );
+
+    /// Reads a vector of plain values.
+    template <typename T> void read( vector<T>& values ){
+        static_assert( is_trivially_copyable<T>::value, "Only vectors of plain types can be read directly." );
+        uint64_t iSize = 0;
+        read( iSize );
+        if ( !good() || iSize > mf_remaining()/sizeof( T ) ){
+            m_File.setstate( ios::failbit );
+            return;
+        }
+
+        values.resize( iSize );
+        m_File.read( reinterpret_cast<char*>( values.data() ), iSize*sizeof( T ) );
+    }
+
+    /// Returns false if the file could not be opened, it is not a checkpoint or a read went past its end.
+    inline bool good(){ return m_File.good(); }
+
+private:
+    /// Returns the number of bytes that have not been read yet
+    uint64_t mf_remaining();
+
+    /// The stream of the checkpoint
+    ifstream m_File;
+};
+
+}
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,216 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "composition_rejection_selector.h"
+#include "extLibs/random_generator.h"
+#include "checkpoint.h"
+
+namespace Engine
+{
+
+/// The exponents of the doubles are in [-1073, 1024] so they are shifted to start from zero
+static const int iBinOffset = 1074;
+
+CompositionRejectionSelector::CompositionRejectionSelector( RandomGen::RandomGenerator* randomGen ):
+    m_pRandomGen( randomGen ),
+    m_iLow( 0 ),
+    m_iHigh( -1 ),
+    m_dTotal( 0.0 ),
+    m_dCancellation( 1.0e4 )
+{
+    m_sName = "composition";
+}
+
+CompositionRejectionSelector::~CompositionRejectionSelector(){}
+
+void CompositionRejectionSelector::init( int size )
+{
+    m_vRates.assign( size, 0.0 );
+    m_vBin.assign( size, -1 );
+    m_vPos.assign( size, -1 );
+
+    m_vBins.assign( 2*iBinOffset, vector<int>() );
+    m_vBinTotals.assign( 2*iBinOffset, 0.0 );
+
+    m_iLow = 0;
+    m_iHigh = -1;
+    m_dTotal = 0.0;
+}
+
+int CompositionRejectionSelector::mf_getBin( double rate )
+{
+    int iExp;
+    frexp( rate, &iExp );
+    return iExp + iBinOffset;
+}
+
+void CompositionRejectionSelector::mf_insert( int id, int bin )
+{
+    m_vBin[ id ] = bin;
+    m_vPos[ id ] = m_vBins[ bin ].size();
+    m_vBins[ bin ].push_back( id );
+
+    if ( m_iHigh < m_iLow ){
+        m_iLow = bin;
+        m_iHigh = bin;
+    }
+    else {
+        m_iLow = min( m_iLow, bin );
+        m_iHigh = max( m_iHigh, bin );
+    }
+}
+
+void CompositionRejectionSelector::mf_erase( int id )
+{
+    int iBin = m_vBin[ id ];
+    vector<int>& bin = m_vBins[ iBin ];
+
+    //Swap with the last class of the bin and drop it
+    int iLast = bin.back();
+    bin[ m_vPos[ id ] ] = iLast;
+    m_vPos[ iLast ] = m_vPos[ id ];
+    bin.pop_back();
+
+    m_vBin[ id ] = -1;
+    m_vPos[ id ] = -1;
+
+    //An empty bin holds exactly zero so no round-off is left behind
+    if ( bin.empty() ){
+        m_vBinTotals[ iBin ] = 0.0;
+
+        while ( m_iHigh >= m_iLow && m_vBins[ m_iHigh ].empty() )
+            m_iHigh--;
+        while ( m_iLow <= m_iHigh && m_vBins[ m_iLow ].empty() )
+            m_iLow++;
+    }
+}
+
+void CompositionRejectionSelector::update( int id, double rate )
+{
+    double dOld = m_dTotal;
+    int iBin = rate > 0.0 ? mf_getBin( rate ) : -1;
+
+    if ( m_vBin[ id ] >= 0 ){
+        m_vBinTotals[ m_vBin[ id ] ] -= m_vRates[ id ];
+        if ( m_vBin[ id ] != iBin )
+            mf_erase( id );
+    }
+
+    m_dTotal += rate - m_vRates[ id ];
+    m_vRates[ id ] = rate;
+
+    if ( iBin >= 0 ){
+        if ( m_vBin[ id ] != iBin )
+            mf_insert( id, iBin );
+        m_vBinTotals[ iBin ] += rate;
+    }
+
+    //Cancellation: the bins are well conditioned (their rates differ at most by a factor of two) so the total is recomputed from them
+    if ( fabs( dOld ) > m_dCancellation*fabs( m_dTotal ) ){
+        m_dTotal = 0.0;
+        for ( int b = m_iLow; b <= m_iHigh; b++ )
+            m_dTotal += m_vBinTotals[ b ];
+    }
+}
+
+double CompositionRejectionSelector::getRate( int id ){ return m_vRates[ id ]; }
+
+double CompositionRejectionSelector::getTotalRate(){ return m_dTotal; }
+
+double CompositionRejectionSelector::resum()
+{
+    double dTotal = 0.0;
+    for ( int b = m_iLow; b <= m_iHigh; b++ ){
+        m_vBinTotals[ b ] = 0.0;
+        for ( int id:m_vBins[ b ] )
+            m_vBinTotals[ b ] += m_vRates[ id ];
+
+        dTotal += m_vBinTotals[ b ];
+    }
+
+    double dDrift = m_dTotal - dTotal;
+    m_dTotal = dTotal;
+
+    return dDrift;
+}
+
+int CompositionRejectionSelector::select( double random )
+{
+    if ( m_dTotal <= 0.0 || m_iHigh < m_iLow )
+        return -1;
+
+    //Composition: the bins with the largest rates are visited first as they are the most probable
+    double dTarget = random*m_dTotal;
+    double dSum = 0.0;
+    int iBin = -1;
+    for ( int b = m_iHigh; b >= m_iLow; b-- ){
+        if ( m_vBins[ b ].empty() )
+            continue;
+
+        //Round-off: if the target is never reached the last non empty bin is kept
+        iBin = b;
+        dSum += m_vBinTotals[ b ];
+        if ( dTarget < dSum )
+            break;
+    }
+
+    //Rejection: pick a class of the bin uniformly and accept it with probability rate/2^b
+    const vector<int>& bin = m_vBins[ iBin ];
+    double dMax = ldexp( 1.0, iBin - iBinOffset );
+    while ( true ){
+        int id = bin[ m_pRandomGen->getIntRandom( 0, bin.size() - 1 ) ];
+        if ( m_pRandomGen->getDoubleRandom()*dMax < m_vRates[ id ] )
+            return id;
+    }
+}
+
+void CompositionRejectionSelector::save( CheckpointWriter& checkpoint )
+{
+    checkpoint.write( m_vRates );
+    checkpoint.write( m_vBin );
+    checkpoint.write( m_vPos );
+
+    //The order of the classes in a bin decides which class is picked so it is kept as it is
+    checkpoint.write( (int)m_vBins.size() );
+    for ( const vector<int>& bin:m_vBins )
+        checkpoint.write( bin );
+
+    checkpoint.write( m_vBinTotals );
+    checkpoint.write( m_iLow );
+    checkpoint.write( m_iHigh );
+    checkpoint.write( m_dTotal );
+}
+
+void CompositionRejectionSelector::load( CheckpointReader& checkpoint )
+{
+    checkpoint.read( m_vRates );
+    checkpoint.read( m_vBin );
+    checkpoint.read( m_vPos );
+
+    int iBins = 0;
+    checkpoint.read( iBins );
+    m_vBins.assign( checkpoint.good() ? iBins : 0, vector<int>() );
+    for ( vector<int>& bin:m_vBins )
+        checkpoint.read( bin );
+
+    checkpoint.read( m_vBinTotals );
+    checkpoint.read( m_iLow );
+    checkpoint.read( m_iHigh );
+    checkpoint.read( m_dTotal );
+}
+
+}
@@ -0,0 +1,94 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef COMPOSITION_REJECTION_SELECTOR_H
+#define COMPOSITION_REJECTION_SELECTOR_H
+
+#include <vector>
+#include <cmath>
+
+#include "selector.h"
+
+namespace RandomGen { class RandomGenerator; }
+
+namespace Engine
+{
+
+/** The composition-rejection selection (Slepoy, Thompson and Plimpton, J. Chem. Phys. 128, 205101 (2008)).
+ * The classes are grouped in bins of rates that differ at most by a factor of two i.e. the bin b holds the rates in [2^(b-1), 2^b).
+ * A bin is selected by scanning the bins with its total rate (composition) and then a class of the bin
+ * is picked uniformly and accepted with probability rate/2^b (rejection) so at least half of the attempts are accepted.
+ * Both updates and selections are O(1) in the number of classes and O(B) in the number of bins B
+ * which is bounded by the range of the rates (e.g. 1e15 over 0.4 gives ~50 bins).
+ * It uses additional random numbers for the rejection so it selects different classes than the linear scan for the same seed. */
+class CompositionRejectionSelector: public Selector
+{
+public:
+    CompositionRejectionSelector( RandomGen::RandomGenerator* randomGen );
+    ~CompositionRejectionSelector() override;
+
+    void init( int size ) override;
+    void update( int id, double rate ) override;
+    double getRate( int id ) override;
+    double getTotalRate() override;
+    double resum() override;
+    int select( double random ) override;
+    void save( CheckpointWriter& checkpoint ) override;
+    void load( CheckpointReader& checkpoint ) override;
+
+private:
+    /// Returns the bin of a (positive) rate
+    int mf_getBin( double rate );
+
+    /// Adds the class in the bin
+    void mf_insert( int id, int bin );
+
+    /// Removes the class from its bin
+    void mf_erase( int id );
+
+    /// The random generator for the rejection step
+    RandomGen::RandomGenerator* m_pRandomGen;
+
+    /// The rate of each class
+    vector<double> m_vRates;
+
+    /// The bin of each class (-1 if its rate is zero)
+    vector<int> m_vBin;
+
+    /// The position of each class in its bin
+    vector<int> m_vPos;
+
+    /// The classes in each bin
+    vector< vector<int> > m_vBins;
+
+    /// The sum of the rates of the classes in each bin
+    vector<double> m_vBinTotals;
+
+    /// The lowest and the highest bin that may hold classes
+    int m_iLow;
+    int m_iHigh;
+
+    /// The running sum of the rates
+    double m_dTotal;
+
+    /// If an update shrinks the running sum by more than this factor the sum is recomputed from the bins
+    double m_dCancellation;
+};
+
+}
+
+#endif // COMPOSITION_REJECTION_SELECTOR_H
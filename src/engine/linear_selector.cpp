@@ -0,0 +1,94 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "linear_selector.h"
+#include "checkpoint.h"
+
+namespace Engine
+{
+
+LinearSelector::LinearSelector():m_dTotal(0.0), m_dCancellation(1.0e4){ m_sName = "linear"; }
+LinearSelector::~LinearSelector(){}
+
+void LinearSelector::init( int size )
+{
+    m_vRates.assign( size, 0.0 );
+    m_dTotal = 0.0;
+}
+
+void LinearSelector::update( int id, double rate )
+{
+    double dOld = m_dTotal;
+    m_dTotal += rate - m_vRates[ id ];
+    m_vRates[ id ] = rate;
+
+    //Cancellation: a large rate left the total (e.g. a fast reaction class emptied) and the
+    //remaining digits are round-off. Resum exactly which costs the same as a selection.
+    if ( fabs( dOld ) > m_dCancellation*fabs( m_dTotal ) )
+        resum();
+}
+
+double LinearSelector::getRate( int id ){ return m_vRates[ id ]; }
+
+double LinearSelector::getTotalRate(){ return m_dTotal; }
+
+double LinearSelector::resum()
+{
+    double dTotal = 0.0;
+    for ( double rate:m_vRates )
+        dTotal += rate;
+
+    double dDrift = m_dTotal - dTotal;
+    m_dTotal = dTotal;
+
+    return dDrift;
+}
+
+int LinearSelector::select( double random )
+{
+    double dTotal = m_dTotal;
+    if ( dTotal <= 0.0 )
+        return -1;
+
+    double dSum = 0.0;
+    for ( int i = 0; i < m_vRates.size(); i++ ){
+        dSum += m_vRates[ i ]/dTotal;
+        if ( m_vRates[ i ] > 0.0 && random <= dSum )
+            return i;
+    }
+
+    //Round-off: the random number is above the accumulated sum, so take the last class that can be selected
+    for ( int i = m_vRates.size() - 1; i >= 0; i-- )
+        if ( m_vRates[ i ] > 0.0 )
+            return i;
+
+    return -1;
+}
+
+void LinearSelector::save( CheckpointWriter& checkpoint )
+{
+    checkpoint.write( m_vRates );
+    checkpoint.write( m_dTotal );
+}
+
+void LinearSelector::load( CheckpointReader& checkpoint )
+{
+    checkpoint.read( m_vRates );
+    checkpoint.read( m_dTotal );
+}
+
+}
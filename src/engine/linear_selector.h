@@ -0,0 +1,62 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef LINEAR_SELECTOR_H
+#define LINEAR_SELECTOR_H
+
+#include <vector>
+#include <cmath>
+
+#include "selector.h"
+
+namespace Engine
+{
+
+/** The linear scan selection. The classes are visited in the order of their IDs
+ * and the first class for which the cumulative normalized rate exceeds the random number is selected.
+ * Selection is O(P) in the number of classes P while the total rate is kept as a running sum.
+ * This is the default method. */
+class LinearSelector: public Selector
+{
+public:
+    LinearSelector();
+    ~LinearSelector() override;
+
+    void init( int size ) override;
+    void update( int id, double rate ) override;
+    double getRate( int id ) override;
+    double getTotalRate() override;
+    double resum() override;
+    int select( double random ) override;
+    void save( CheckpointWriter& checkpoint ) override;
+    void load( CheckpointReader& checkpoint ) override;
+
+private:
+    /// The rate of each class
+    vector<double> m_vRates;
+
+    /// The running sum of the rates. It is updated with the difference of the rate of a class
+    /// every time the class changes so it accumulates round-off until resum() is called.
+    double m_dTotal;
+
+    /// If an update shrinks the running sum by more than this factor the sum is recomputed exactly
+    double m_dCancellation;
+};
+
+}
+
+#endif // LINEAR_SELECTOR_H
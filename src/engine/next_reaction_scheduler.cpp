@@ -0,0 +1,169 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "next_reaction_scheduler.h"
+#include "extLibs/random_generator.h"
+#include "checkpoint.h"
+
+namespace Engine
+{
+
+NextReactionScheduler::NextReactionScheduler( RandomGen::RandomGenerator* randomGen ):m_pRandomGen( randomGen ){}
+
+NextReactionScheduler::~NextReactionScheduler(){}
+
+void NextReactionScheduler::init( const vector<int>& events )
+{
+    m_vOffsets.assign( events.size(), 0 );
+    size_t iTotal = 0;
+    for ( unsigned int p = 0; p < events.size(); p++ ){
+        m_vOffsets[ p ] = iTotal;
+        iTotal += events[ p ];
+    }
+
+    m_vHeap.clear();
+    m_vPos.assign( iTotal, -1 );
+}
+
+double NextReactionScheduler::mf_drawTime( double rate, double time )
+{
+    return time - log( m_pRandomGen->getDoubleRandom() )/rate;
+}
+
+void NextReactionScheduler::update( int process, int site, double rate, double time )
+{
+    size_t iEvent = mf_index( process, site );
+    int iPos = m_vPos[ iEvent ];
+
+    //A new event
+    if ( iPos < 0 ){
+        if ( rate <= 0.0 )
+            return;
+
+        Event event;
+        event.dTime = mf_drawTime( rate, time );
+        event.dRate = rate;
+        event.iProcess = process;
+        event.iSite = site;
+
+        m_vPos[ iEvent ] = m_vHeap.size();
+        m_vHeap.push_back( event );
+        mf_siftUp( m_vHeap.size() - 1 );
+        return;
+    }
+
+    //The event cannot be performed anymore: the last event takes its place
+    if ( rate <= 0.0 ){
+        int iLast = m_vHeap.size() - 1;
+        mf_swap( iPos, iLast );
+        m_vHeap.pop_back();
+        m_vPos[ iEvent ] = -1;
+
+        if ( iPos < iLast ){
+            size_t iMoved = mf_index( m_vHeap[ iPos ].iProcess, m_vHeap[ iPos ].iSite );
+            mf_siftUp( iPos );
+            mf_siftDown( m_vPos[ iMoved ] );
+        }
+        return;
+    }
+
+    //The rate changed: reuse the random number by rescaling the remaining time
+    Event& event = m_vHeap[ iPos ];
+    if ( event.dRate == rate )
+        return;
+
+    double dOld = event.dTime;
+    event.dTime = time + ( event.dRate/rate )*( event.dTime - time );
+    event.dRate = rate;
+
+    if ( event.dTime < dOld )
+        mf_siftUp( iPos );
+    else
+        mf_siftDown( iPos );
+}
+
+void NextReactionScheduler::fired( int process, int site, double time )
+{
+    int iPos = m_vPos[ mf_index( process, site ) ];
+    if ( iPos < 0 )
+        return;
+
+    m_vHeap[ iPos ].dTime = mf_drawTime( m_vHeap[ iPos ].dRate, time );
+    mf_siftDown( iPos );
+}
+
+double NextReactionScheduler::getRate( int process, int site )
+{
+    int iPos = m_vPos[ mf_index( process, site ) ];
+    return iPos < 0 ? 0.0 : m_vHeap[ iPos ].dRate;
+}
+
+void NextReactionScheduler::mf_swap( int pos1, int pos2 )
+{
+    swap( m_vHeap[ pos1 ], m_vHeap[ pos2 ] );
+    m_vPos[ mf_index( m_vHeap[ pos1 ].iProcess, m_vHeap[ pos1 ].iSite ) ] = pos1;
+    m_vPos[ mf_index( m_vHeap[ pos2 ].iProcess, m_vHeap[ pos2 ].iSite ) ] = pos2;
+}
+
+void NextReactionScheduler::mf_siftUp( int pos )
+{
+    while ( pos > 0 ){
+        int iParent = ( pos - 1 )/2;
+        if ( m_vHeap[ iParent ].dTime <= m_vHeap[ pos ].dTime )
+            break;
+
+        mf_swap( pos, iParent );
+        pos = iParent;
+    }
+}
+
+void NextReactionScheduler::mf_siftDown( int pos )
+{
+    int iSize = m_vHeap.size();
+    while ( true ){
+        int iSmallest = pos;
+        int iLeft = 2*pos + 1;
+        int iRight = 2*pos + 2;
+
+        if ( iLeft < iSize && m_vHeap[ iLeft ].dTime < m_vHeap[ iSmallest ].dTime )
+            iSmallest = iLeft;
+        if ( iRight < iSize && m_vHeap[ iRight ].dTime < m_vHeap[ iSmallest ].dTime )
+            iSmallest = iRight;
+
+        if ( iSmallest == pos )
+            break;
+
+        mf_swap( pos, iSmallest );
+        pos = iSmallest;
+    }
+}
+
+void NextReactionScheduler::save( CheckpointWriter& checkpoint )
+{
+    checkpoint.write( m_vOffsets );
+    checkpoint.write( m_vHeap );
+    checkpoint.write( m_vPos );
+}
+
+void NextReactionScheduler::load( CheckpointReader& checkpoint )
+{
+    checkpoint.read( m_vOffsets );
+    checkpoint.read( m_vHeap );
+    checkpoint.read( m_vPos );
+}
+
+}
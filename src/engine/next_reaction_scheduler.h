@@ -0,0 +1,128 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef NEXT_REACTION_SCHEDULER_H
+#define NEXT_REACTION_SCHEDULER_H
+
+#include <vector>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace RandomGen { class RandomGenerator; }
+
+namespace Engine
+{
+
+class CheckpointWriter;
+class CheckpointReader;
+
+/** The next reaction method (Gibson and Bruck, J. Phys. Chem. A 104, 1876 (2000)).
+ * Every event i.e. a process that can be performed in a site has its own rate and a putative firing time
+ * and the events are kept in an indexed binary heap ordered by their firing times, so the next event is
+ * always at the top. Updating the rate of an event is O(log E) in the number of events E.
+ * The random numbers are reused: if the rate of an event changes from a_old to a_new its firing time t_f
+ * is rescaled as t + a_old/a_new(t_f - t). A new random number is drawn only for the event that fired
+ * and for the events that become possible again (which is statistically exact as the firing times are exponential).
+ * The events are identified by the ID of their process and the ID of their site (or bond for the pair processes). */
+class NextReactionScheduler
+{
+public:
+    NextReactionScheduler( RandomGen::RandomGenerator* randomGen );
+    virtual ~NextReactionScheduler();
+
+    /// Allocates the scheduler for the given number of events of each process. No event is scheduled.
+    void init( const vector<int>& events );
+
+    /// Sets the rate of the event of the process in the site at the given time.
+    /// A zero rate removes the event.
+    void update( int process, int site, double rate, double time );
+
+    /// Draws a new firing time for the event that fired at the given time.
+    void fired( int process, int site, double time );
+
+    /// Returns true if no event can be performed.
+    inline bool empty(){ return m_vHeap.empty(); }
+
+    /// Returns the firing time of the next event.
+    inline double getNextTime(){ return m_vHeap.empty() ? numeric_limits<double>::infinity() : m_vHeap[ 0 ].dTime; }
+
+    /// Returns the process of the next event.
+    inline int getNextProcess(){ return m_vHeap[ 0 ].iProcess; }
+
+    /// Returns the site of the next event.
+    inline int getNextSite(){ return m_vHeap[ 0 ].iSite; }
+
+    /// Returns the rate of the event of the process in the site (zero if it is not scheduled).
+    double getRate( int process, int site );
+
+    /// Returns the number of scheduled events.
+    inline int size(){ return m_vHeap.size(); }
+
+    /// Writes the scheduled events (their firing times, rates and the order of the heap) in a checkpoint.
+    void save( CheckpointWriter& checkpoint );
+
+    /// Restores the events written by save(). The scheduler must have been initialized for the same events.
+    void load( CheckpointReader& checkpoint );
+
+private:
+    /// A scheduled event
+    struct Event
+    {
+        /// The putative firing time
+        double dTime;
+
+        /// The rate
+        double dRate;
+
+        /// The process of the event
+        int iProcess;
+
+        /// The site (or bond) of the event
+        int iSite;
+    };
+
+    /// Returns the index of the event of the process in the site
+    inline size_t mf_index( int process, int site ){ return m_vOffsets[ process ] + site; }
+
+    /// Draws a firing time after time for the given rate
+    double mf_drawTime( double rate, double time );
+
+    /// Moves the event at the given position of the heap up/down until the heap is ordered again
+    void mf_siftUp( int pos );
+    void mf_siftDown( int pos );
+
+    /// Swaps two events of the heap and updates their positions
+    void mf_swap( int pos1, int pos2 );
+
+    /// The random generator for drawing the firing times
+    RandomGen::RandomGenerator* m_pRandomGen;
+
+    /// The index of the first event of each process (the events of a process follow each other)
+    vector<size_t> m_vOffsets;
+
+    /// The binary heap of the scheduled events (the children of i are at 2i+1 and 2i+2)
+    vector<Event> m_vHeap;
+
+    /// The position of each event in the heap (-1 if it is not scheduled)
+    vector<int> m_vPos;
+};
+
+}
+
+#endif // NEXT_REACTION_SCHEDULER_H
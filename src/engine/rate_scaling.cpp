@@ -0,0 +1,138 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "rate_scaling.h"
+#include "checkpoint.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace Engine
+{
+
+RateScaling::RateScaling( int stage, double tolerance, double fast, long minimum ):
+    m_iStage( stage ),
+    m_dTolerance( tolerance ),
+    m_dFast( fast ),
+    m_iMinimum( minimum ),
+    m_iEvents( 0 ),
+    m_iStages( 0 )
+{
+    //The statistical error of the executions N of a balanced pair is sqrt(N)
+    if ( m_iMinimum <= 0 )
+        m_iMinimum = tolerance > 0.0 ? min( (double)stage, ceil( 4.0/( tolerance*tolerance ) ) ) : stage;
+}
+
+RateScaling::~RateScaling(){}
+
+void RateScaling::init( const vector<int>& channels, const vector<int>& reverse )
+{
+    m_vChannel = channels;
+    m_vReverse = reverse;
+    m_vFactor.assign( reverse.size(), 1.0 );
+    m_vCounts.assign( reverse.size(), 0 );
+    m_vRaised.assign( reverse.size(), 0 );
+    m_vLowered.assign( reverse.size(), 0 );
+    m_iEvents = 0;
+}
+
+bool RateScaling::endStage( const vector<double>& rates )
+{
+    int iChannels = m_vReverse.size();
+
+    //The total rate of every channel
+    vector<double> vRates( iChannels, 0.0 );
+    for ( unsigned int p = 0; p < rates.size(); p++ )
+        vRates[ m_vChannel[ p ] ] += rates[ p ];
+
+    //A pair is quasi-equilibrated if it was performed often enough and as many times forward as reverse.
+    //A channel that is its own reverse is balanced if it raised the coordination as many times as it lowered it.
+    //Every pair is visited from its channel with the smallest ID.
+    vector<bool> vEquilibrated( iChannels, false );
+    double dSlowRate = 0.0;
+    bool bChanged = false;
+    for ( int c = 0; c < iChannels; c++ ){
+        int r = m_vReverse[ c ];
+        if ( r < c ){
+            if ( r < 0 )
+                dSlowRate += vRates[ c ];
+            continue;
+        }
+
+        long iForward = r == c ? m_vRaised[ c ] : m_vCounts[ c ], iReverse = r == c ? m_vLowered[ c ] : m_vCounts[ r ];
+        long iTotal = r == c ? m_vCounts[ c ] : iForward + iReverse;
+        if ( iTotal >= m_iMinimum && fabs( (double)( iForward - iReverse ) ) <= m_dTolerance*( iForward + iReverse ) )
+            vEquilibrated[ c ] = vEquilibrated[ r ] = true;
+        else {
+            dSlowRate += r == c ? vRates[ c ] : vRates[ c ] + vRates[ r ];
+
+            //A scaled pair that is not equilibrated any more (and not just rarely performed) is scaled back up
+            if ( iTotal >= m_iMinimum && m_vFactor[ c ] < 1.0 ){
+                m_vFactor[ c ] = m_vFactor[ r ] = min( 1.0, m_vFactor[ c ]*m_dFast );
+                bChanged = true;
+            }
+        }
+    }
+
+    //Every quasi-equilibrated pair is scaled to the fast ratio times the rate of the slow processes (never above its real rate).
+    //Without slow processes there is nothing to compare with and the factors are kept.
+    for ( int c = 0; c < iChannels; c++ ){
+        int r = m_vReverse[ c ];
+        if ( !vEquilibrated[ c ] || r < c )
+            continue;
+
+        double dRate = r == c ? vRates[ c ] : vRates[ c ] + vRates[ r ];
+        if ( dSlowRate <= 0.0 || dRate <= 0.0 )
+            continue;
+
+        double dFactor = min( 1.0, m_vFactor[ c ]*m_dFast*dSlowRate/dRate );
+        if ( dFactor != m_vFactor[ c ] ){
+            m_vFactor[ c ] = m_vFactor[ r ] = dFactor;
+            bChanged = true;
+        }
+    }
+
+    m_vCounts.assign( iChannels, 0 );
+    m_vRaised.assign( iChannels, 0 );
+    m_vLowered.assign( iChannels, 0 );
+    m_iEvents = 0;
+    m_iStages++;
+
+    return bChanged;
+}
+
+void RateScaling::save( CheckpointWriter& checkpoint )
+{
+    checkpoint.write( m_vFactor );
+    checkpoint.write( m_vCounts );
+    checkpoint.write( m_vRaised );
+    checkpoint.write( m_vLowered );
+    checkpoint.write( m_iEvents );
+    checkpoint.write( m_iStages );
+}
+
+void RateScaling::load( CheckpointReader& checkpoint )
+{
+    checkpoint.read( m_vFactor );
+    checkpoint.read( m_vCounts );
+    checkpoint.read( m_vRaised );
+    checkpoint.read( m_vLowered );
+    checkpoint.read( m_iEvents );
+    checkpoint.read( m_iStages );
+}
+
+}
@@ -0,0 +1,132 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef RATE_SCALING_H
+#define RATE_SCALING_H
+
+#include <vector>
+
+using namespace std;
+
+namespace Engine
+{
+
+class CheckpointWriter;
+class CheckpointReader;
+
+/** Accelerates a run by scaling down the rates of the fast processes that are quasi-equilibrated
+ * (Dybeck, Plaisance and Neurock, J. Chem. Theory Comput. 13, 1525 (2017), after Chatterjee and Voter).
+ * The processes are grouped in channels (the processes of the same equation e.g. the desorptions of every coordination)
+ * and a channel may have a reverse channel (e.g. an adsorption and the desorption of the same species) or be its own reverse
+ * (a diffusion). The run is split in stages of a fixed number of events. At the end of a stage a channel and its reverse
+ * are quasi-equilibrated if they were performed at least the minimum number of times and their forward and reverse
+ * executions differ less than the tolerance. For a channel that is its own reverse the forward and reverse executions are
+ * the events that raise and lower the coordination (e.g. the hops onto and off a step edge). Their rates are then scaled by the same factor so that together they are
+ * the fast ratio times the total rate of the processes that are not quasi-equilibrated (the slow ones), which are never scaled.
+ * A scaled pair that is performed often enough but is not equilibrated any more is scaled back up by the fast ratio.
+ * As the forward and the reverse rates are scaled together their equilibrium is kept and so are the statistics of the slow processes. */
+class RateScaling
+{
+public:
+    /// The events of a stage, the tolerance of the quasi-equilibrium, the ratio of the executions of a quasi-equilibrated pair
+    /// to those of the slow processes that the scaling keeps and the executions of a stage for a pair to be tested (0 for 4/tolerance^2,
+    /// for which the executions of a balanced pair are within the tolerance at two standard deviations, up to the events of a stage).
+    RateScaling( int stage, double tolerance, double fast, long minimum = 0 );
+
+    virtual ~RateScaling();
+
+    /// Sets the channel of every process (indexed by the ID of the process) and the reverse of every channel (-1 if none).
+    /// Every factor starts from 1.
+    void init( const vector<int>& channels, const vector<int>& reverse );
+
+    /// Counts an event of the process with the change of the coordination that it caused (see isOwnReverse).
+    /// Returns true if the stage is over.
+    inline bool count( int process, int coordination = 0 ){
+        int c = m_vChannel[ process ];
+        m_vCounts[ c ]++;
+        if ( coordination > 0 )
+            m_vRaised[ c ]++;
+        else if ( coordination < 0 )
+            m_vLowered[ c ]++;
+
+        return ++m_iEvents >= m_iStage;
+    }
+
+    /// Ends the stage: decides the new factors from the executions of the stage and the current (scaled) total rate of every process.
+    /// Returns true if any factor changed.
+    bool endStage( const vector<double>& rates );
+
+    /// Returns the factor that scales the rate of the process.
+    inline double getFactor( int process ){ return m_vFactor[ m_vChannel[ process ] ]; }
+
+    /// Returns true if the process has a reverse i.e. its rate may be scaled.
+    inline bool isReversible( int process ){ return m_vReverse[ m_vChannel[ process ] ] >= 0; }
+
+    /// Returns true if the process is its own reverse (e.g. a diffusion) so its events must be counted with the change of the coordination.
+    inline bool isOwnReverse( int process ){ return m_vReverse[ m_vChannel[ process ] ] == m_vChannel[ process ]; }
+
+    /// Returns the executions of a stage for a pair to be tested.
+    inline long getMinimum(){ return m_iMinimum; }
+
+    /// Returns the number of stages that have ended.
+    inline long getNumStages(){ return m_iStages; }
+
+    /// Writes the factors and the executions of the current stage in a checkpoint.
+    void save( CheckpointWriter& checkpoint );
+
+    /// Restores the state written by save(). It must have been initialized with the same channels.
+    void load( CheckpointReader& checkpoint );
+
+private:
+    /// The events of a stage
+    int m_iStage;
+
+    /// The tolerance of the quasi-equilibrium: the largest |forward - reverse|/(forward + reverse)
+    double m_dTolerance;
+
+    /// The ratio of the executions of a quasi-equilibrated pair to those of the slow processes
+    double m_dFast;
+
+    /// The executions of a stage for a pair to be tested
+    long m_iMinimum;
+
+    /// The channel of every process (indexed by the ID of the process)
+    vector<int> m_vChannel;
+
+    /// The reverse of every channel (-1 if none)
+    vector<int> m_vReverse;
+
+    /// The factor of every channel
+    vector<double> m_vFactor;
+
+    /// The executions of every channel in the current stage
+    vector<long> m_vCounts;
+
+    /// The executions of every channel in the current stage that raised/lowered the coordination
+    vector<long> m_vRaised;
+    vector<long> m_vLowered;
+
+    /// The events of the current stage
+    int m_iEvents;
+
+    /// The number of stages that have ended
+    long m_iStages;
+};
+
+}
+
+#endif // RATE_SCALING_H
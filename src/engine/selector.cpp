@@ -0,0 +1,39 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "selector.h"
+#include "linear_selector.h"
+#include "tree_selector.h"
+#include "composition_rejection_selector.h"
+
+namespace Engine
+{
+
+Selector::Selector(){}
+Selector::~Selector(){}
+
+Selector* Selector::create( string name, RandomGen::RandomGenerator* randomGen )
+{
+    if ( name.compare("tree") == 0 )
+        return new TreeSelector();
+    else if ( name.compare("composition") == 0 )
+        return new CompositionRejectionSelector( randomGen );
+
+    return new LinearSelector();
+}
+
+}
@@ -0,0 +1,84 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef SELECTOR_H
+#define SELECTOR_H
+
+#include <string>
+
+using namespace std;
+
+namespace RandomGen { class RandomGenerator; }
+
+/** The pure virtual class from which every event selection method is generated.
+ * A selector holds the rate of each process class (i.e. the rate constant of the process
+ * multiplied by the number of sites in its class) and, given a random number,
+ * returns the class where the next event will be performed.
+ * The classes are identified by the ID of their process. */
+namespace Engine
+{
+
+class CheckpointWriter;
+class CheckpointReader;
+
+class Selector
+{
+public:
+    Selector();
+    virtual ~Selector();
+
+    /// Allocates the selector for the given number of classes. All rates are initialized to zero.
+    virtual void init( int size ) = 0;
+
+    /// Sets the rate of the class with the given ID.
+    virtual void update( int id, double rate ) = 0;
+
+    /// Returns the rate of the class with the given ID.
+    virtual double getRate( int id ) = 0;
+
+    /// Returns the sum of the rates of all the classes.
+    virtual double getTotalRate() = 0;
+
+    /// Recomputes exactly the sum of the rates of all the classes from the rate of each class
+    /// and returns the difference from the total rate before the recomputation (i.e. the round-off drift).
+    virtual double resum() = 0;
+
+    /// Given a random number in [0, 1) returns the ID of the selected class.
+    /// Returns -1 if no class can be selected (i.e. the total rate is zero).
+    virtual int select( double random ) = 0;
+
+    /// Writes the state of the selection (the rates and the running sums) in a checkpoint.
+    virtual void save( CheckpointWriter& checkpoint ) = 0;
+
+    /// Restores the state written by save() so the next selections are the same as those of the saved run.
+    virtual void load( CheckpointReader& checkpoint ) = 0;
+
+    /// Returns the name of the selection method as given in the input file.
+    inline string getName(){ return m_sName; }
+
+    /// Creates the selection method with the given name (linear, tree or composition).
+    /// The random generator is given to the methods that need additional random numbers.
+    static Selector* create( string name, RandomGen::RandomGenerator* randomGen );
+
+protected:
+    /// The name of the selection method
+    string m_sName;
+};
+
+}
+
+#endif // SELECTOR_H
@@ -0,0 +1,35 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "site_class.h"
+
+namespace Engine
+{
+
+SiteClass::SiteClass( int latticeSize, const vector<int>* index ):m_vPos( latticeSize, -1 ), m_pIndex( index ), m_pAll( 0 ){}
+SiteClass::~SiteClass(){}
+
+void SiteClass::setAll( const vector<Site*>* sites )
+{
+    m_pAll = sites;
+
+    //Nothing is stored for an implicit class
+    vector<Site*>().swap( m_vSites );
+    vector<int>().swap( m_vPos );
+}
+
+}
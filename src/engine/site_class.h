@@ -0,0 +1,128 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef SITE_CLASS_H
+#define SITE_CLASS_H
+
+#include <vector>
+
+#include "site.h"
+
+using namespace std;
+using namespace SurfaceTiles;
+
+namespace Engine
+{
+
+/** The class of the sites where a process can be performed.
+ * The sites are stored densely in a vector and the position of each site in the vector
+ * is indexed by the ID of the site. Removing a site moves the last site in its position (swap-remove).
+ * This gives O(1) insertion, removal, membership test and access of a site by its position
+ * (i.e. uniform random pick). The order of the sites changes when a site is removed.
+ * A class that holds only a part of the lattice (e.g. a domain in parallel runs) can be given an index
+ * which maps the ID of each site to its position in that part, so the class is allocated for the part only.
+ * A class can also be implicit i.e. always all the sites of a given list (e.g. of a process that is accepted everywhere):
+ * then nothing is stored, inserting and removing do nothing and a site is picked directly from the list. */
+class SiteClass
+{
+public:
+    /// Constructor for a lattice with the given number of sites.
+    /// If an index is given, the sites are indexed with index[ ID ] which must be in [0, latticeSize).
+    SiteClass( int latticeSize = 0, const vector<int>* index = 0 );
+
+    virtual ~SiteClass();
+
+    /// Makes the class implicit: it holds all the given sites (in their order) without storing them. The list is not owned.
+    void setAll( const vector<Site*>* sites );
+
+    /// Returns true if the class is implicit.
+    inline bool isAll() const { return m_pAll; }
+
+    /// Adds the site in the class (if it is not already there).
+    inline void insert( Site* s ){
+        if ( m_pAll )
+            return;
+
+        int iIndex = mf_index( s );
+        if ( m_vPos[ iIndex ] != -1 )
+            return;
+
+        m_vPos[ iIndex ] = m_vSites.size();
+        m_vSites.push_back( s );
+    }
+
+    /// Removes the site from the class (if it is there).
+    inline void erase( Site* s ){
+        if ( m_pAll )
+            return;
+
+        int iIndex = mf_index( s );
+        int iPos = m_vPos[ iIndex ];
+        if ( iPos == -1 )
+            return;
+
+        Site* last = m_vSites.back();
+        m_vSites[ iPos ] = last;
+        m_vPos[ mf_index( last ) ] = iPos;
+
+        m_vSites.pop_back();
+        m_vPos[ iIndex ] = -1;
+    }
+
+    /// Removes all the sites from the class (an implicit class keeps all its sites).
+    inline void clear(){
+        if ( m_pAll )
+            return;
+
+        for ( Site* s:m_vSites )
+            m_vPos[ mf_index( s ) ] = -1;
+
+        m_vSites.clear();
+    }
+
+    /// Returns true if the site is in the class.
+    inline bool contains( Site* s ) const { return m_pAll || m_vPos[ mf_index( s ) ] != -1; }
+
+    /// Returns the number of sites in the class.
+    inline int size() const { return m_pAll ? m_pAll->size() : m_vSites.size(); }
+
+    /// Returns the site in the given position of the class [0, size()).
+    inline Site* getSite( int pos ) const { return m_pAll ? (*m_pAll)[ pos ] : m_vSites[ pos ]; }
+
+    /// Returns the sites of the class.
+    inline const vector<Site*>& getSites() const { return m_pAll ? *m_pAll : m_vSites; }
+
+private:
+    /// Returns the position of the site in m_vPos
+    inline int mf_index( Site* s ) const { return m_pIndex ? (*m_pIndex)[ s->getID() ] : s->getID(); }
+
+    /// The sites of the class.
+    vector<Site*> m_vSites;
+
+    /// The position of each site in m_vSites (-1 if the site is not in the class). Indexed by the site ID.
+    vector<int> m_vPos;
+
+    /// Maps the ID of a site to its position in m_vPos (null if the ID is used directly). Not owned.
+    const vector<int>* m_pIndex;
+
+    /// The sites of an implicit class (null if the sites are stored). Not owned.
+    const vector<Site*>* m_pAll;
+};
+
+}
+
+#endif // SITE_CLASS_H
@@ -0,0 +1,354 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "synchronous_sublattice.h"
+#include "process.h"
+#include "lattice.h"
+#include "extLibs/random_generator.h"
+
+#include <cmath>
+#include <climits>
+
+namespace Engine
+{
+
+SynchronousSublattice::SynchronousSublattice( Lattice* lattice, int domains, double window ):
+    m_pLattice( lattice ),
+    m_iDomainsX( 1 ),
+    m_iDomainsY( 1 ),
+    m_dWindow( window ),
+    m_iMinWidth( INT_MAX )
+{
+    int iX = m_pLattice->getX();
+    int iY = m_pLattice->getY();
+
+    //The domains are arranged in the grid whose domains are the closest to squares
+    double dBest = -1.0;
+    for ( int dx = 1; dx <= domains; dx++ ){
+        if ( domains%dx != 0 )
+            continue;
+
+        int dy = domains/dx;
+        double dDiff = fabs( (double)iX/dx - (double)iY/dy );
+        if ( dBest < 0.0 || dDiff < dBest ){
+            dBest = dDiff;
+            m_iDomainsX = dx;
+            m_iDomainsY = dy;
+        }
+    }
+
+    //Every domain is split in two in x and y: the sublattice is 2*(row half) + (column half)
+    int iSize = m_pLattice->getSize();
+    m_vDomain.resize( iSize );
+    m_vSublattice.resize( iSize );
+    m_vLocal.resize( iSize );
+    m_vRegionSize.assign( 4*getNumDomains(), 0 );
+    m_vRegionSites.resize( 4*getNumDomains() );
+    m_vBondLocal.resize( m_pLattice->getNumBonds() );
+    m_vRegionBonds.assign( 4*getNumDomains(), 0 );
+
+    for ( int d = 0; d < m_iDomainsX; d++ ){
+        int x0 = d*iX/m_iDomainsX, x1 = ( d + 1 )*iX/m_iDomainsX, xm = ( x0 + x1 )/2;
+        m_iMinWidth = min( m_iMinWidth, min( xm - x0, x1 - xm ) );
+    }
+
+    for ( int d = 0; d < m_iDomainsY; d++ ){
+        int y0 = d*iY/m_iDomainsY, y1 = ( d + 1 )*iY/m_iDomainsY, ym = ( y0 + y1 )/2;
+        m_iMinWidth = min( m_iMinWidth, min( ym - y0, y1 - ym ) );
+    }
+
+    //The domains follow the position of the sites in the lattice (their IDs follow the order of the storage)
+    for ( int iPos = 0; iPos < iSize; iPos++ ){
+        int iRow = iPos/iX;
+        int iCol = iPos%iX;
+        int id = m_pLattice->getSite( iRow, iCol )->getID();
+
+        int dx = iCol*m_iDomainsX/iX;
+        int dy = iRow*m_iDomainsY/iY;
+        int xm = ( dx*iX/m_iDomainsX + ( dx + 1 )*iX/m_iDomainsX )/2;
+        int ym = ( dy*iY/m_iDomainsY + ( dy + 1 )*iY/m_iDomainsY )/2;
+
+        m_vDomain[ id ] = dy*m_iDomainsX + dx;
+        m_vSublattice[ id ] = 2*( iRow >= ym ) + ( iCol >= xm );
+        m_vLocal[ id ] = m_vRegionSize[ 4*m_vDomain[ id ] + m_vSublattice[ id ] ]++;
+        m_vRegionSites[ 4*m_vDomain[ id ] + m_vSublattice[ id ] ].push_back( m_pLattice->getSite( id ) );
+
+        //The bonds belong to the sublattice of their site
+        Site* s = m_pLattice->getSite( id );
+        for ( int i = 0; i < s->getNeighs().size(); i++ )
+            m_vBondLocal[ s->getBond( i ) ] = m_vRegionBonds[ 4*m_vDomain[ id ] + m_vSublattice[ id ] ]++;
+    }
+}
+
+SynchronousSublattice::~SynchronousSublattice()
+{
+    for ( Domain& domain:m_vDomains ){
+        for ( MicroProcesses::Process* p:domain.vProcesses )
+            delete p;
+
+        for ( Region& region:domain.vRegions )
+            delete region.pSelector;
+
+        delete domain.pRandomGen;
+    }
+}
+
+void SynchronousSublattice::init( const vector<MicroProcesses::Process*>& processes, const vector<const SiteClass*>& classes,
+                                  const vector<const BondClass*>& bondClasses, const vector<RandomGen::RandomGenerator*>& randomGens, string selection )
+{
+    m_vDomains.resize( getNumDomains() );
+
+    for ( int d = 0; d < getNumDomains(); d++ ){
+        Domain& domain = m_vDomains[ d ];
+        domain.pRandomGen = randomGens[ d ];
+        domain.iEvents = 0;
+        domain.iEvaluated = 0;
+        domain.iSkipped = 0;
+
+        for ( MicroProcesses::Process* p:processes ){
+            MicroProcesses::Process* clone = p->clone();
+            clone->setRandomGen( domain.pRandomGen );
+            domain.vProcesses.push_back( clone );
+        }
+
+        for ( int r = 0; r < 4; r++ ){
+            Region& region = domain.vRegions[ r ];
+            region.vClasses.assign( processes.size(), SiteClass( m_vRegionSize[ 4*d + r ], &m_vLocal ) );
+            for ( unsigned int id = 0; id < classes.size(); id++ )
+                if ( classes[ id ]->isAll() )
+                    region.vClasses[ id ].setAll( &m_vRegionSites[ 4*d + r ] );
+
+            region.vBondClasses.resize( processes.size() );
+            for ( unsigned int id = 0; id < bondClasses.size(); id++ )
+                if ( bondClasses[ id ] )
+                    region.vBondClasses[ id ] = BondClass( m_vRegionBonds[ 4*d + r ], &m_vBondLocal );
+
+            region.pSelector = Selector::create( selection, domain.pRandomGen );
+            region.pSelector->init( processes.size() );
+        }
+    }
+
+    //Every site of the classes of the whole lattice goes to the class of its region (the implicit classes have them already)
+    for ( unsigned int id = 0; id < classes.size(); id++ )
+        if ( !classes[ id ]->isAll() )
+            for ( Site* s:classes[ id ]->getSites() )
+                m_vDomains[ m_vDomain[ s->getID() ] ].vRegions[ m_vSublattice[ s->getID() ] ].vClasses[ id ].insert( s );
+
+    for ( unsigned int id = 0; id < bondClasses.size(); id++ )
+        if ( bondClasses[ id ] )
+            for ( const Bond& bond:bondClasses[ id ]->getBonds() )
+                m_vDomains[ m_vDomain[ bond.pSite->getID() ] ].vRegions[ m_vSublattice[ bond.pSite->getID() ] ].vBondClasses[ id ].insert( bond.iID, bond.pSite, bond.pNeighbour );
+
+    for ( Domain& domain:m_vDomains )
+        for ( Region& region:domain.vRegions )
+            for ( MicroProcesses::Process* p:domain.vProcesses )
+                region.pSelector->update( p->getID(), p->getRateConstant()*(double)mf_classSize( region, p ) );
+}
+
+void SynchronousSublattice::cycle( int sublattice )
+{
+    int iDomains = m_vDomains.size();
+
+    #pragma omp parallel for schedule( static )
+    for ( int d = 0; d < iDomains; d++ )
+        mf_runWindow( d, sublattice );
+
+    //The ghost sites are re-tested by their owner in the order of the domains
+    //so that the result does not depend on which thread finished first
+    for ( Domain& domain:m_vDomains ){
+        for ( Site* s:domain.vGhosts ){
+            Domain& owner = m_vDomains[ m_vDomain[ s->getID() ] ];
+            for ( MicroProcesses::Process* p:owner.vProcesses ){
+                if ( p->isPairProcess() )
+                    mf_testBonds( owner, p, s );
+                else if ( !p->isUncoAccepted() )
+                    mf_test( owner, p, s );
+            }
+        }
+        domain.vGhosts.clear();
+    }
+}
+
+void SynchronousSublattice::mf_runWindow( int d, int sublattice )
+{
+    Domain& domain = m_vDomains[ d ];
+    Region& region = domain.vRegions[ sublattice ];
+
+    //The running total rate of the region is recomputed at the beginning of every window
+    region.pSelector->resum();
+
+    double dTime = 0.0;
+    while ( true ){
+        double dRTot = region.pSelector->getTotalRate();
+        if ( dRTot <= 0.0 )
+            break;
+
+        dTime += -log( domain.pRandomGen->getDoubleRandom() )/dRTot;
+        if ( dTime > m_dWindow )
+            break;
+
+        int iProc = region.pSelector->select( domain.pRandomGen->getDoubleRandom() );
+        if ( iProc < 0 )
+            break;
+
+        MicroProcesses::Process* proc = domain.vProcesses[ iProc ];
+        if ( proc->isPairProcess() ){
+            BondClass& bondClass = region.vBondClasses[ iProc ];
+            const Bond& bond = bondClass.getBond( domain.pRandomGen->getIntRandom( 0, bondClass.size() - 1 ) );
+            proc->performPair( bond.pSite, bond.pNeighbour );
+        }
+        else {
+            SiteClass& procClass = region.vClasses[ iProc ];
+            proc->perform( procClass.getSite( domain.pRandomGen->getIntRandom( 0, procClass.size() - 1 ) ) );
+        }
+
+        proc->eventHappened();
+        domain.iEvents++;
+
+        //The affected sites of other domains are left for the exchange at the end of the cycle
+        for ( Site* affectedSite:proc->getAffectedSites() )
+            if ( m_vDomain[ affectedSite->getID() ] != d )
+                domain.vGhosts.push_back( affectedSite );
+
+        //The sites of this domain are re-tested as in the serial run
+        int iWrites = proc->getWrites();
+        long iAffected = proc->getAffectedSites().size();
+        for ( MicroProcesses::Process* p2:domain.vProcesses ){
+            if ( p2->isUncoAccepted() )
+                continue;
+
+            if ( ( p2->getReads() & iWrites ) == 0 ){
+                domain.iSkipped += iAffected;
+                continue;
+            }
+
+            const set<Site*>& sites = p2->getRadius() == 0 ? proc->getModifiedSites() : proc->getAffectedSites();
+            domain.iSkipped += iAffected - (long)sites.size();
+
+            for ( Site* affectedSite:sites ){
+                if ( m_vDomain[ affectedSite->getID() ] != d )
+                    continue;
+
+                if ( p2->isPairProcess() )
+                    mf_testBonds( domain, p2, affectedSite );
+                else
+                    mf_test( domain, p2, affectedSite );
+            }
+        }
+    }
+}
+
+void SynchronousSublattice::mf_test( Domain& domain, MicroProcesses::Process* process, Site* s )
+{
+    Region& region = domain.vRegions[ m_vSublattice[ s->getID() ] ];
+    SiteClass& siteClass = region.vClasses[ process->getID() ];
+
+    domain.iEvaluated++;
+
+    //Only a change of the classes of the site (its mask) changes the class
+    ClassMask iBit = (ClassMask)1 << process->getID();
+    bool bIn = process->rules( s );
+    if ( bIn == ( ( s->getClassMask() & iBit ) != 0 ) )
+        return;
+
+    s->setClassMask( s->getClassMask() ^ iBit );
+    if ( bIn )
+        siteClass.insert( s );
+    else
+        siteClass.erase( s );
+
+    region.pSelector->update( process->getID(), process->getRateConstant()*(double)siteClass.size() );
+}
+
+void SynchronousSublattice::mf_testBonds( Domain& domain, MicroProcesses::Process* process, Site* s )
+{
+    Region& region = domain.vRegions[ m_vSublattice[ s->getID() ] ];
+    BondClass& bondClass = region.vBondClasses[ process->getID() ];
+    NeighbourSpan neighs = s->getNeighs();
+    bool bResized = false;
+
+    domain.iEvaluated += neighs.size();
+    for ( int i = 0; i < (int)neighs.size(); i++ ){
+        int iBond = s->getBond( i );
+        bool bIn = process->pairRules( s, neighs[ i ] );
+        if ( bIn == bondClass.contains( iBond ) )
+            continue;
+
+        if ( bIn )
+            bondClass.insert( iBond, s, neighs[ i ] );
+        else
+            bondClass.erase( iBond );
+
+        bResized = true;
+    }
+
+    if ( bResized )
+        region.pSelector->update( process->getID(), process->getRateConstant()*(double)bondClass.size() );
+}
+
+inline int SynchronousSublattice::mf_classSize( Region& region, MicroProcesses::Process* process )
+{
+    return process->isPairProcess() ? region.vBondClasses[ process->getID() ].size() : region.vClasses[ process->getID() ].size();
+}
+
+long SynchronousSublattice::getNumEventHappened( int process )
+{
+    long iEvents = 0;
+    for ( Domain& domain:m_vDomains )
+        iEvents += domain.vProcesses[ process ]->getNumEventHappened();
+
+    return iEvents;
+}
+
+int SynchronousSublattice::getClassSize( int process )
+{
+    int iSize = 0;
+    for ( Domain& domain:m_vDomains )
+        for ( Region& region:domain.vRegions )
+            iSize += mf_classSize( region, m_vDomains[ 0 ].vProcesses[ process ] );
+
+    return iSize;
+}
+
+long SynchronousSublattice::getNumEvents()
+{
+    long iEvents = 0;
+    for ( Domain& domain:m_vDomains )
+        iEvents += domain.iEvents;
+
+    return iEvents;
+}
+
+long SynchronousSublattice::getEvaluatedRules()
+{
+    long iEvaluated = 0;
+    for ( Domain& domain:m_vDomains )
+        iEvaluated += domain.iEvaluated;
+
+    return iEvaluated;
+}
+
+long SynchronousSublattice::getSkippedRules()
+{
+    long iSkipped = 0;
+    for ( Domain& domain:m_vDomains )
+        iSkipped += domain.iSkipped;
+
+    return iSkipped;
+}
+
+}
@@ -0,0 +1,182 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef SYNCHRONOUS_SUBLATTICE_H
+#define SYNCHRONOUS_SUBLATTICE_H
+
+#include <vector>
+#include <string>
+
+#include "site_class.h"
+#include "bond_class.h"
+#include "selector.h"
+
+using namespace std;
+
+namespace MicroProcesses { class Process; }
+namespace RandomGen { class RandomGenerator; }
+class Lattice;
+
+namespace Engine
+{
+
+/** The synchronous sublattice parallel KMC (Shim and Amar, Phys. Rev. B 71, 125432 (2005)).
+ * The lattice is partitioned in rectangular domains and every domain in 2x2 sublattices.
+ * In every cycle all the domains perform in parallel (OpenMP) the events of the same sublattice for a fixed
+ * time window, each with its own clones of the processes, random generator and selection.
+ * The active sublattices of two domains are separated by a whole sublattice so the events of different threads
+ * never read or write the same sites. The lattice is shared, so the sites of the neighbouring domains that an event
+ * affects (the ghost sites) are not copied: they are re-tested by their owner at the end of the cycle.
+ * The results depend on the number of domains but not on the number of threads. */
+class SynchronousSublattice
+{
+public:
+    /// Partitions the lattice in the given number of domains for the given time window.
+    SynchronousSublattice( Lattice* lattice, int domains, double window );
+
+    virtual ~SynchronousSublattice();
+
+    /// The minimum width (in sites) of a sublattice. An event writes up to the neighbours of its site (of the neighbour
+    /// that it hops to for a diffusion) and the affected sites are re-tested by rules that read their neighbours,
+    /// so two active sublattices must be further apart than this.
+    static const int iMinWidth = 7;
+
+    /// Builds the domains from the processes (ordered by their ID) and their classes in the whole lattice
+    /// (the classes of the bonds for the pair processes, null for the others).
+    /// Every domain gets its random generator (owned by the domains) and its selection method.
+    void init( const vector<MicroProcesses::Process*>& processes, const vector<const SiteClass*>& classes,
+               const vector<const BondClass*>& bondClasses, const vector<RandomGen::RandomGenerator*>& randomGens, string selection );
+
+    /// Performs one cycle: every domain performs the events of the given sublattice [0, 4) for the time window
+    /// and then the ghost sites are re-tested.
+    void cycle( int sublattice );
+
+    /// Returns the time window for which the active sublattice is performed in a cycle.
+    inline double getWindow(){ return m_dWindow; }
+
+    /// Returns the time that a cycle advances the simulation. Every sublattice is active in one of four cycles
+    /// (on average) for the time window, so that every site is performed for the whole simulated time.
+    inline double getCycleTime(){ return m_dWindow/4.0; }
+
+    /// Returns the number of domains.
+    inline int getNumDomains(){ return m_iDomainsX*m_iDomainsY; }
+
+    /// Returns the number of domains in x and y.
+    inline int getDomainsX(){ return m_iDomainsX; }
+    inline int getDomainsY(){ return m_iDomainsY; }
+
+    /// Returns the width of the narrowest sublattice.
+    inline int getMinWidth(){ return m_iMinWidth; }
+
+    /// Returns how many times the process with the given ID happened in all the domains.
+    long getNumEventHappened( int process );
+
+    /// Returns the number of sites (bonds for a pair process) where the process with the given ID can be performed in all the domains.
+    int getClassSize( int process );
+
+    /// Returns the number of events / rule evaluations / skipped rule evaluations of all the domains.
+    long getNumEvents();
+    long getEvaluatedRules();
+    long getSkippedRules();
+
+private:
+    /// A sublattice of a domain
+    struct Region
+    {
+        /// The class of each process in the region (indexed by the ID of the process)
+        vector<SiteClass> vClasses;
+
+        /// The class of the bonds of each pair process in the region (a bond belongs to the region of its site)
+        vector<BondClass> vBondClasses;
+
+        /// The selection of the process classes of the region
+        Selector* pSelector;
+    };
+
+    /// A domain with everything that a thread needs
+    struct Domain
+    {
+        /// The clones of the processes (indexed by their ID)
+        vector<MicroProcesses::Process*> vProcesses;
+
+        /// The random generator of the domain
+        RandomGen::RandomGenerator* pRandomGen;
+
+        /// The four sublattices
+        Region vRegions[ 4 ];
+
+        /// The sites of other domains affected in this cycle
+        vector<Site*> vGhosts;
+
+        long iEvents;
+        long iEvaluated;
+        long iSkipped;
+    };
+
+    /// Performs the events of the sublattice of the domain until the time window is exceeded
+    void mf_runWindow( int domain, int sublattice );
+
+    /// Tests the rules of the process in the site and updates its class in the domain
+    void mf_test( Domain& domain, MicroProcesses::Process* process, Site* s );
+
+    /// Tests the rules of the pair process in the bonds from the site to its neighbours and updates their class in the domain
+    void mf_testBonds( Domain& domain, MicroProcesses::Process* process, Site* s );
+
+    /// Returns the number of events (sites or bonds) of the process in the region
+    inline int mf_classSize( Region& region, MicroProcesses::Process* process );
+
+    /// The lattice
+    Lattice* m_pLattice;
+
+    /// The number of domains in x and y
+    int m_iDomainsX;
+    int m_iDomainsY;
+
+    /// The time window
+    double m_dWindow;
+
+    /// The width of the narrowest sublattice
+    int m_iMinWidth;
+
+    /// The domain of each site (indexed by the site ID)
+    vector<int> m_vDomain;
+
+    /// The sublattice of each site (indexed by the site ID)
+    vector<int> m_vSublattice;
+
+    /// The position of each site in its sublattice (indexed by the site ID)
+    vector<int> m_vLocal;
+
+    /// The number of sites of each sublattice (domain*4 + sublattice)
+    vector<int> m_vRegionSize;
+
+    /// The position of each bond in the sublattice of its site (indexed by the bond ID)
+    vector<int> m_vBondLocal;
+
+    /// The number of bonds of each sublattice (domain*4 + sublattice)
+    vector<int> m_vRegionBonds;
+
+    /// The sites of each sublattice (domain*4 + sublattice) in their position in it, for the implicit classes
+    vector< vector<Site*> > m_vRegionSites;
+
+    /// The domains
+    vector<Domain> m_vDomains;
+};
+
+}
+
+#endif // SYNCHRONOUS_SUBLATTICE_H
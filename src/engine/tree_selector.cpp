@@ -0,0 +1,112 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "tree_selector.h"
+#include "checkpoint.h"
+
+namespace Engine
+{
+
+TreeSelector::TreeSelector():m_iLeaves(1), m_iSize(0){ m_sName = "tree"; }
+TreeSelector::~TreeSelector(){}
+
+void TreeSelector::init( int size )
+{
+    m_iSize = size;
+
+    m_iLeaves = 1;
+    while ( m_iLeaves < size )
+        m_iLeaves *= 2;
+
+    m_vTree.assign( 2*m_iLeaves, 0.0 );
+}
+
+void TreeSelector::update( int id, double rate )
+{
+    int iNode = m_iLeaves + id;
+    m_vTree[ iNode ] = rate;
+
+    //The sums are recomputed (not incremented) so no round-off accumulates in the internal nodes
+    for ( iNode /= 2; iNode >= 1; iNode /= 2 )
+        m_vTree[ iNode ] = m_vTree[ 2*iNode ] + m_vTree[ 2*iNode + 1 ];
+}
+
+double TreeSelector::getRate( int id ){ return m_vTree[ m_iLeaves + id ]; }
+
+double TreeSelector::getTotalRate(){ return m_iSize > 1 ? m_vTree[ 1 ] : m_vTree[ m_iLeaves ]; }
+
+double TreeSelector::resum()
+{
+    double dTotal = getTotalRate();
+
+    for ( int iNode = m_iLeaves - 1; iNode >= 1; iNode-- )
+        m_vTree[ iNode ] = m_vTree[ 2*iNode ] + m_vTree[ 2*iNode + 1 ];
+
+    return dTotal - getTotalRate();
+}
+
+int TreeSelector::select( double random )
+{
+    if ( getTotalRate() <= 0.0 )
+        return -1;
+
+    double dTarget = random*getTotalRate();
+
+    //Go left if the target is within the left sum (same as "random <= sum" of the linear scan)
+    int iNode = 1;
+    while ( iNode < m_iLeaves ){
+        double dLeft = m_vTree[ 2*iNode ];
+        if ( dTarget <= dLeft && dLeft > 0.0 )
+            iNode = 2*iNode;
+        else {
+            dTarget -= dLeft;
+            iNode = 2*iNode + 1;
+        }
+    }
+
+    int id = iNode - m_iLeaves;
+
+    //Round-off: we may have ended up in a class with zero rate so take the closest class that can be selected
+    if ( id < m_iSize && m_vTree[ iNode ] > 0.0 )
+        return id;
+
+    for ( int i = min( id, m_iSize - 1 ); i >= 0; i-- )
+        if ( m_vTree[ m_iLeaves + i ] > 0.0 )
+            return i;
+
+    for ( int i = id + 1; i < m_iSize; i++ )
+        if ( m_vTree[ m_iLeaves + i ] > 0.0 )
+            return i;
+
+    return -1;
+}
+
+void TreeSelector::save( CheckpointWriter& checkpoint )
+{
+    checkpoint.write( m_iSize );
+    checkpoint.write( m_iLeaves );
+    checkpoint.write( m_vTree );
+}
+
+void TreeSelector::load( CheckpointReader& checkpoint )
+{
+    checkpoint.read( m_iSize );
+    checkpoint.read( m_iLeaves );
+    checkpoint.read( m_vTree );
+}
+
+}
@@ -0,0 +1,63 @@
+    //============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef TREE_SELECTOR_H
+#define TREE_SELECTOR_H
+
+#include <vector>
+#include <algorithm>
+
+#include "selector.h"
+
+namespace Engine
+{
+
+/** The binary sum tree selection. The rates of the classes are the leaves of a complete binary tree
+ * and every internal node holds the sum of its two children, so the root is the total rate.
+ * Changing the rate of a class updates the path from its leaf to the root and the selection
+ * descends from the root to a leaf. Both are O(log P) in the number of classes P.
+ * For the same random numbers and the same class order it selects the same classes as the linear scan. */
+class TreeSelector: public Selector
+{
+public:
+    TreeSelector();
+    ~TreeSelector() override;
+
+    void init( int size ) override;
+    void update( int id, double rate ) override;
+    double getRate( int id ) override;
+    double getTotalRate() override;
+    double resum() override;
+    int select( double random ) override;
+    void save( CheckpointWriter& checkpoint ) override;
+    void load( CheckpointReader& checkpoint ) override;
+
+private:
+    /// The number of leaves (the number of classes rounded up to a power of two)
+    int m_iLeaves;
+
+    /// The number of classes
+    int m_iSize;
+
+    /// The tree stored as an array: the root is at 1 and the children of node i are at 2i and 2i+1.
+    /// The leaves start at m_iLeaves.
+    vector<double> m_vTree;
+};
+
+}
+
+#endif // TREE_SELECTOR_H
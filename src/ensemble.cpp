@@ -0,0 +1,149 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "ensemble.h"
+#include "apothesis.h"
+#include "errorhandler.h"
+
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <algorithm>
+
+Ensemble::Ensemble( int argc, char* argv[], int runs, int threads, int seed ):
+    m_iArgc( argc ),
+    m_vcArgv( argv ),
+    m_iRuns( runs ),
+    m_iThreads( threads ),
+    m_iSeed( seed ),
+    m_iNext( 0 )
+{
+    if ( m_iThreads <= 0 )
+        m_iThreads = max( 1u, thread::hardware_concurrency() );
+}
+
+Ensemble::~Ensemble(){}
+
+int Ensemble::exec()
+{
+    m_vColumns.assign( m_iRuns, vector<string>() );
+    m_vSeries.assign( m_iRuns, vector< vector<double> >() );
+    m_vsErrors.assign( m_iRuns, "" );
+
+    //Every thread performs the next run that has not been started until all of them are started
+    m_iNext = 0;
+    vector<thread> vThreads;
+    for ( int i = 0; i < min( m_iThreads, m_iRuns ); i++ )
+        vThreads.push_back( thread( [ this ](){
+            for ( int run = m_iNext++; run < m_iRuns; run = m_iNext++ )
+                mf_run( run );
+        } ) );
+
+    for ( thread& t:vThreads )
+        t.join();
+
+    int iFailed = 0;
+    for ( int run = 0; run < m_iRuns; run++ ){
+        if ( !m_vsErrors[ run ].empty() ){
+            cout << "Run " << run << " failed: " << m_vsErrors[ run ] << endl;
+            iFailed++;
+        }
+    }
+
+    mf_write( "Ensemble.log" );
+
+    return iFailed;
+}
+
+void Ensemble::mf_run( int run )
+{
+    Apothesis* apothesis = 0;
+
+    try {
+        apothesis = new Apothesis( m_iArgc, m_vcArgv, "run_" + to_string( run ) );
+        apothesis->setRandomSeed( m_iSeed + run );
+        apothesis->setRecording( true );
+        apothesis->init();
+        apothesis->exec();
+
+        m_vColumns[ run ] = apothesis->getSeriesColumns();
+        m_vSeries[ run ] = apothesis->getSeries();
+    }
+    catch ( const ApothesisError& error ){
+        string sError = apothesis ? apothesis->pErrorHandler->getLastError() : "";
+        m_vsErrors[ run ] = sError.empty() ? error.what() : sError;
+    }
+
+    delete apothesis;
+}
+
+void Ensemble::mf_write( string file )
+{
+    vector<int> vRuns;
+    for ( int run = 0; run < m_iRuns; run++ )
+        if ( m_vsErrors[ run ].empty() )
+            vRuns.push_back( run );
+
+    if ( vRuns.empty() )
+        return;
+
+    //The quantities are matched by their name as the processes may be ordered differently in every run
+    const vector<string>& vsColumns = m_vColumns[ vRuns[ 0 ] ];
+    vector< vector<int> > vIndex;
+    size_t iRows = m_vSeries[ vRuns[ 0 ] ].size();
+    for ( int run:vRuns ){
+        vector<int> vRunIndex;
+        for ( string column:vsColumns )
+            vRunIndex.push_back( find( m_vColumns[ run ].begin(), m_vColumns[ run ].end(), column ) - m_vColumns[ run ].begin() );
+
+        vIndex.push_back( vRunIndex );
+        iRows = min( iRows, m_vSeries[ run ].size() );
+    }
+
+    ofstream out( file );
+    out << "Ensemble of " << m_iRuns << " runs (" << vRuns.size() << " finished) with random init num "
+        << m_iSeed << " to " << m_iSeed + m_iRuns - 1 << endl;
+    out << endl;
+
+    out << vsColumns[ 0 ] << '\t';
+    for ( unsigned int c = 1; c < vsColumns.size(); c++ )
+        out << vsColumns[ c ] << " (mean)" << '\t' << vsColumns[ c ] << " (variance)" << '\t';
+    out << endl;
+
+    out.precision( 15 );
+    for ( size_t row = 0; row < iRows; row++ ){
+        out << m_vSeries[ vRuns[ 0 ] ][ row ][ 0 ] << '\t';
+
+        for ( unsigned int c = 1; c < vsColumns.size(); c++ ){
+            double dMean = 0.0;
+            for ( unsigned int i = 0; i < vRuns.size(); i++ )
+                dMean += m_vSeries[ vRuns[ i ] ][ row ][ vIndex[ i ][ c ] ];
+            dMean /= vRuns.size();
+
+            //The unbiased variance (zero for a single run)
+            double dVariance = 0.0;
+            for ( unsigned int i = 0; i < vRuns.size(); i++ ){
+                double dDev = m_vSeries[ vRuns[ i ] ][ row ][ vIndex[ i ][ c ] ] - dMean;
+                dVariance += dDev*dDev;
+            }
+            dVariance = vRuns.size() > 1 ? dVariance/( vRuns.size() - 1 ) : 0.0;
+
+            out << dMean << '\t' << dVariance << '\t';
+        }
+        out << endl;
+    }
+}
@@ -0,0 +1,77 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+
+using namespace std;
+
+/** An ensemble of independent runs of the same input, each with its own random generator initializer.
+ * Every run is a separate (self-contained) Apothesis instance writing its files in its own directory (run_<i>).
+ * The runs are performed concurrently by a pool of threads, their time series are kept in memory and
+ * the mean and the variance over the runs of every quantity are written in one log (Ensemble.log). */
+class Ensemble
+{
+public:
+    /// The runs are initialized with seed, seed + 1, ... and performed by the given number of threads (0 for the number of cores).
+    Ensemble( int argc, char* argv[], int runs, int threads, int seed );
+
+    virtual ~Ensemble();
+
+    /// Performs all the runs and writes the merged log. Returns the number of runs that failed.
+    int exec();
+
+private:
+    /// Performs one run and keeps its time series
+    void mf_run( int run );
+
+    /// Writes the mean and the variance of the time series of the runs that finished
+    void mf_write( string file );
+
+    /// The number of flags given by the user
+    int m_iArgc;
+
+    /// The flags given by the user
+    char** m_vcArgv;
+
+    /// The number of runs
+    int m_iRuns;
+
+    /// The number of threads
+    int m_iThreads;
+
+    /// The random generator initializer of the first run
+    int m_iSeed;
+
+    /// The next run to be performed by a thread
+    atomic<int> m_iNext;
+
+    /// The names of the recorded quantities of each run
+    vector< vector<string> > m_vColumns;
+
+    /// The time series of each run
+    vector< vector< vector<double> > > m_vSeries;
+
+    /// The error of each run (empty if it finished)
+    vector<string> m_vsErrors;
+};
+
+#endif // ENSEMBLE_H
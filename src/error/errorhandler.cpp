@@ -32,6 +32,7 @@ ErrorHandler::~ErrorHandler()
 
 void ErrorHandler::error_simple_msg( string msg )
 {
+  m_sLastError = msg;
   cout << "Error:" + msg << endl;
 }
 
@@ -63,6 +63,13 @@ class ErrorHandler: public Pointers
 
     ///  Warning message simple text
     void warningSimple_msg( const string &msg );
+
+    /// Returns the last error message reported
+    inline string getLastError(){ return m_sLastError; }
+
+  private:
+    /// The last error message reported
+    string m_sLastError;
   };
 }
 
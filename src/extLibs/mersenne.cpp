@@ -42,6 +42,20 @@ void CRandomMersenne::RandomInit( int seed ) {
   }
 
 
+void CRandomMersenne::GetState( uint32_t state[], int & index ) const {
+  // Copy the state vector and the index into it
+  for ( int i = 0; i < MERS_N; i++ ) state[i] = mt[i];
+  index = mti;
+  }
+
+
+void CRandomMersenne::SetState( uint32_t const state[], int index ) {
+  // Continue the sequence from a state copied by GetState
+  for ( int i = 0; i < MERS_N; i++ ) mt[i] = state[i];
+  mti = index;
+  }
+
+
 void CRandomMersenne::RandomInitByArray( int const seeds[], int NumSeeds ) {
   // Seed by more than 32 bits
   int i, j, k;
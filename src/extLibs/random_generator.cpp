@@ -1,4 +1,5 @@
 #include "random_generator.h"
+#include "engine/checkpoint.h"
 
 namespace RandomGen {
 
@@ -19,4 +20,25 @@ double RandomGenerator::getDoubleRandom() { return m_mersenne->Random(); }
 
 int RandomGenerator::getIntRandom( int Min, int Max ) { return m_mersenne->IRandom( Min, Max ); }
 
+void RandomGenerator::save( Engine::CheckpointWriter& checkpoint )
+{
+    vector<uint32_t> vState( CRandomMersenne::StateSize );
+    int iIndex = 0;
+    m_mersenne->GetState( vState.data(), iIndex );
+
+    checkpoint.write( vState );
+    checkpoint.write( iIndex );
+}
+
+void RandomGenerator::load( Engine::CheckpointReader& checkpoint )
+{
+    vector<uint32_t> vState;
+    int iIndex = 0;
+    checkpoint.read( vState );
+    checkpoint.read( iIndex );
+
+    if ( checkpoint.good() && vState.size() == CRandomMersenne::StateSize )
+        m_mersenne->SetState( vState.data(), iIndex );
+}
+
 }
@@ -11,6 +11,8 @@
 
 class CRandomMersenne;
 
+namespace Engine { class CheckpointWriter; class CheckpointReader; }
+
 namespace RandomGen {
 
 class RandomGenerator : public Pointers
@@ -30,6 +32,12 @@ class RandomGenerator : public Pointers
     /// Returns a random integer number from the interval [Min,Max]
     int getIntRandom( int Min, int Max );
 
+    /// Writes the state of the generator in a checkpoint.
+    void save( Engine::CheckpointWriter& checkpoint );
+
+    /// Restores the state written by save() so the generator continues the sequence of the saved run.
+    void load( Engine::CheckpointReader& checkpoint );
+
   private:
     /// The random generator used in the computations
     CRandomMersenne* m_mersenne;
@@ -173,6 +173,9 @@ public:
    int IRandomX(int min, int max);     // Output random integer, exact
    double Random();                    // Output random float
    uint32_t BRandom();                 // Output random bits
+   static const int StateSize = MERS_N;// Number of words of the state
+   void GetState(uint32_t state[], int & index) const; // Copy the state (e.g. for a checkpoint)
+   void SetState(uint32_t const state[], int index);   // Continue from a copied state
 private:
    void Init0(int seed);               // Basic initialization procedure
    uint32_t mt[MERS_N];                // State vector
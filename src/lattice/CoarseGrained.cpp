@@ -0,0 +1,113 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "CoarseGrained.h"
+#include "parameters.h"
+
+CoarseGrained::CoarseGrained( Apothesis* apothesis ) : SimpleCubic( apothesis ), m_iCellEdge( 0 ), m_iSitesPerCell( 1 ), m_iNumSpecies( 0 ), m_iVacant( 0 )
+{
+    ;
+}
+
+CoarseGrained::~CoarseGrained(){}
+
+void CoarseGrained::build()
+{
+    if ( m_iCellEdge < 1 || m_iSizeX%m_iCellEdge != 0 || m_iSizeY%m_iCellEdge != 0 ){
+        m_errorHandler->error_simple_msg("The dimensions of the coarse-grained lattice must be multiples of the edge of its cells.");
+        EXIT
+    }
+
+    if ( m_hasSteps ){
+        m_errorHandler->error_simple_msg("The coarse-grained lattice cannot have steps.");
+        EXIT
+    }
+
+    //The cells are the sites of the lattice
+    m_iSitesPerCell = m_iCellEdge*m_iCellEdge;
+    m_iSizeX /= m_iCellEdge;
+    m_iSizeY /= m_iCellEdge;
+
+    SimpleCubic::build();
+
+    for ( Site* s:m_vSites )
+        s->setHeight( m_iSitesPerCell*m_iHeight );
+
+    m_iVacant = m_parameters->getSpeciesRegistry().add( m_sLabel );
+    m_viOccupied.assign( getSize(), 0 );
+    m_viCounts.clear();
+    m_iNumSpecies = 0;
+}
+
+void CoarseGrained::copyFrom( Lattice* lattice )
+{
+    Lattice::copyFrom( lattice );
+
+    CoarseGrained* cells = static_cast<CoarseGrained*>( lattice );
+    m_iCellEdge = cells->m_iCellEdge;
+    m_iSitesPerCell = cells->m_iSitesPerCell;
+    m_iNumSpecies = cells->m_iNumSpecies;
+    m_iVacant = cells->m_iVacant;
+    m_viCounts = cells->m_viCounts;
+    m_viOccupied = cells->m_viOccupied;
+}
+
+void CoarseGrained::computeSpeciesCounts()
+{
+    int iNumSpecies = m_parameters->getSpeciesRegistry().size();
+    if ( iNumSpecies != m_iNumSpecies ){
+        vector<int> viCounts( getSize()*iNumSpecies, 0 );
+        for ( int i = 0; i < getSize(); i++ )
+            for ( int j = 0; j < m_iNumSpecies; j++ )
+                viCounts[ i*iNumSpecies + j ] = m_viCounts[ i*m_iNumSpecies + j ];
+
+        m_viCounts.swap( viCounts );
+        m_iNumSpecies = iNumSpecies;
+    }
+
+    m_viSpeciesCount.assign( m_iNumSpecies, 0 );
+    for ( int i = 0; i < getSize(); i++ ){
+        for ( int j = 0; j < m_iNumSpecies; j++ )
+            m_viSpeciesCount[ j ] += m_viCounts[ i*m_iNumSpecies + j ];
+
+        m_viSpeciesCount[ m_iVacant ] += m_iSitesPerCell - m_viOccupied[ i ];
+    }
+}
+
+void CoarseGrained::changeCount( Site* cell, int species, int dn )
+{
+    m_viCounts[ cell->getID()*m_iNumSpecies + species ] += dn;
+    m_viOccupied[ cell->getID() ] += dn;
+
+    m_viSpeciesCount[ species ] += dn;
+    m_viSpeciesCount[ m_iVacant ] -= dn;
+
+    mf_label( cell );
+}
+
+void CoarseGrained::mf_label( Site* cell )
+{
+    int iSpecies = m_iVacant, iMax = getVacant( cell );
+    for ( int j = 0; j < m_iNumSpecies; j++ ){
+        if ( m_viCounts[ cell->getID()*m_iNumSpecies + j ] > iMax ){
+            iSpecies = j;
+            iMax = m_viCounts[ cell->getID()*m_iNumSpecies + j ];
+        }
+    }
+
+    cell->setSpecies( iSpecies );
+}
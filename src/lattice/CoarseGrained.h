@@ -0,0 +1,96 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef COARSEGRAINED_H
+#define COARSEGRAINED_H
+
+#include <vector>
+
+#include "SimpleCubic.h"
+
+using namespace std;
+using namespace SurfaceTiles;
+using namespace Utils;
+
+/** A coarse-grained simple cubic lattice for very large surfaces. Every site of it is a square cell of edge x edge sites
+ * of the surface which keeps only the numbers of the species adsorbed in it (the rest of its sites are vacant) and the sum
+ * of the heights of its sites. The processes compute their rates from these numbers in the local mean-field of the cell
+ * (e.g. the adsorption in the vacant sites, the reaction in the pairs of neighbouring reactants expected in the cell)
+ * and the diffusion is performed as hops between neighbouring cells. The dimensions of the lattice are given in sites
+ * and the cells are numbered, written and counted as its sites (at the coarse resolution of the cells). */
+class CoarseGrained : public SimpleCubic
+{
+public:
+  /// Constructor
+  CoarseGrained( Apothesis* apothesis );
+
+  /// Distructor.
+  virtual ~CoarseGrained();
+
+  /// Sets the edge of the cells in sites. It must be set before the lattice is built.
+  inline void setCellEdge( int edge ){ m_iCellEdge = edge; }
+
+  /// Returns the edge of the cells in sites.
+  inline int getCellEdge(){ return m_iCellEdge; }
+
+  /// Builds the cells of the lattice. The dimensions of the lattice (in sites) must be multiples of the edge of the cells.
+  /// The height of every cell is the sum of the initial heights of its sites.
+  void build() override;
+
+  /// Builds the lattice as a copy of a coarse-grained lattice already built from the same input (with the numbers of its cells).
+  void copyFrom( Lattice* lattice ) override;
+
+  inline int getSitesPerCell() override { return m_iSitesPerCell; }
+
+  /// Sums the numbers of the species of the cells (the species registered since the last call start from zero in every cell).
+  /// The vacant sites are counted as the species of the lattice.
+  void computeSpeciesCounts() override;
+
+  /// Returns the number of sites of the cell with the given species (by its ID).
+  inline int getCount( Site* cell, int species ){ return species < m_iNumSpecies ? m_viCounts[ cell->getID()*m_iNumSpecies + species ] : 0; }
+
+  /// Returns the number of vacant sites of the cell.
+  inline int getVacant( Site* cell ){ return m_iSitesPerCell - m_viOccupied[ cell->getID() ]; }
+
+  /// Adds the given number of sites with the species (by its ID) in the cell (removes them if it is negative) and updates
+  /// the counts of the species of the lattice. The cell is labelled with its most frequent species.
+  void changeCount( Site* cell, int species, int dn );
+
+private:
+  /// Labels the cell with its most frequent species (its vacant sites are the species of the lattice).
+  void mf_label( Site* cell );
+
+  /// The edge of the cells in sites
+  int m_iCellEdge;
+
+  /// The number of sites in every cell (the square of the edge)
+  int m_iSitesPerCell;
+
+  /// The number of species that the numbers of the cells are kept for
+  int m_iNumSpecies;
+
+  /// The ID of the species of the lattice i.e. of the vacant sites
+  int m_iVacant;
+
+  /// The number of sites with every species in every cell (indexed by the ID of the cell times m_iNumSpecies plus the ID of the species)
+  vector<int> m_viCounts;
+
+  /// The number of occupied sites in every cell (by its ID)
+  vector<int> m_viOccupied;
+};
+
+#endif // COARSEGRAINED_H
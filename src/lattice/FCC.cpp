@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "FCC.h"
+#include "stencil.h"
 
 FCC::FCC(Apothesis* apothesis):Lattice(apothesis)
 {
@@ -27,15 +28,11 @@ void FCC::setInitialHeight( int  height ) { m_iHeight = height; }
 void FCC::build()
 {
     // The sites of the lattice.
-    m_vSites.resize( getSize() );
-    for ( int i = 0; i < m_vSites.size(); i++)
-        m_vSites[ i ] = new Site();
+    mf_allocateSites();
 
     if ( m_sOrient == "111"){
         if ( m_iSizeX%2 != 0 || m_iSizeX%2 != 0){
             cout << "Error:The size of the lattice must be an even number in each direction." << endl;
-            for ( int i = 0; i < m_vSites.size(); i++)
-                delete m_vSites[ i ];
             EXIT
         }
 
@@ -52,21 +49,17 @@ void FCC::build()
             if (i%2 == 0)
                 for (int j = i*m_iSizeY; j < (m_iSizeY + i*m_iSizeY); j++)
                     if (j%2 == 0){
-                        m_vSites[ j]->setID( j);
                         m_vSites[ j]->setHeight( m_iHeight -1 );
                     }
                     else{
-                        m_vSites[ j]->setID( j);
                         m_vSites[ j]->setHeight( m_iHeight );
                     }
             else
                 for (int j = i*m_iSizeY; j < (m_iSizeY + i*m_iSizeY); j++)
                     if (j%2 == 0){
-                        m_vSites[ j]->setID( j);
                         m_vSites[ j]->setHeight( m_iHeight );
                     }
                     else{
-                        m_vSites[ j]->setID( j);
                         m_vSites[ j]->setHeight( m_iHeight - 1);
                     }
         }
@@ -77,8 +70,6 @@ void FCC::build()
 
         if ( m_iSizeX%2 != 0 ){
             cout << "Error:The size of the lattice in the x-direciton must be an even number." << endl;
-            for ( int i = 0; i < m_vSites.size(); i++)
-                delete m_vSites[ i ];
             EXIT
         }
 
@@ -89,11 +80,9 @@ void FCC::build()
                 iPos = i*m_iSizeX + j;
 
                 if ( j%2 != 0 ){
-                    m_vSites[ iPos ]->setID( iPos );
                     m_vSites[ iPos ]->setHeight( m_iHeight - 1 );
                 }
                 else {
-                    m_vSites[ iPos ]->setID( iPos );
                     m_vSites[ iPos ]->setHeight( m_iHeight );
                 }
             }
@@ -103,13 +92,10 @@ void FCC::build()
     }
     else if ( m_sOrient == "100") {  }
 
+    m_Neighbours.compress();
 }
 
-FCC::~FCC()
-{
-    for ( int i = 0; i<getSize(); i++)
-        delete m_vSites[i];
-}
+FCC::~FCC(){}
 
 void FCC::buildSteps( int iSizeX, int iSizeY ){;}
 
@@ -147,840 +133,25 @@ void FCC::mf_neigh_110()
     // The neighbors for 15 in level 0 (same height) are: 13 (West), 17 (East), 9 (North), 21 (South)
     //             level -1, 1 (a level below/above) are: 14 (West Up), 20 (West down), 16 (East up), 22 (East down)
 
-    int iPos = 0;
-    /* All except the boundaries */
-    for ( int i = 1; i < m_iSizeY - 1; i++ ){
-        for (int j = 2; j < m_iSizeX -2; j++) {
-            iPos  = i*m_iSizeX + j;
-
-            //Same level
-            m_vSites[ iPos ]->set1stNeibors(0, m_vSites[ iPos - m_iSizeX ] ); //North
-            m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos - m_iSizeX ],  Site::NORTH );
-
-            m_vSites[ iPos ]->set1stNeibors(0, m_vSites[ iPos + m_iSizeX ]); //South
-            m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos + m_iSizeX ],  Site::SOUTH);
-
-            m_vSites[ iPos ]->set1stNeibors(0, m_vSites[ iPos - 2 ]); //West
-            m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos + m_iSizeX ],  Site::WEST);
-
-            m_vSites[ iPos ]->set1stNeibors(0, m_vSites[ iPos + 2 ]); //East
-            m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos + m_iSizeX ],  Site::WEST);
-
-            //Next|Previous level
-            if ( iPos%2 == 0){
-                m_vSites[ iPos ]->set1stNeibors(-1, m_vSites[ iPos - m_iSizeX + 1 ] );
-                m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos - m_iSizeX + 1 ],  Site::EAST_UP );
-
-                m_vSites[ iPos ]->set1stNeibors(-1, m_vSites[ iPos - m_iSizeX - 1 ] );
-                m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos - m_iSizeX - 1 ],  Site::WEST_UP );
-
-                m_vSites[ iPos ]->set1stNeibors(-1, m_vSites[ iPos - 1 ] );
-                m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos - 1 ],  Site::WEST_DOWN );
-                m_vSites[ iPos ]->set1stNeibors(-1, m_vSites[ iPos + 1 ] );
-                m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos + 1 ],  Site::EAST_DOWN );
-            }
-            else {
-                m_vSites[ iPos ]->set1stNeibors(-1, m_vSites[ iPos + 1 ] );
-                m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos +1 ],  Site::EAST_UP );
-                m_vSites[ iPos ]->set1stNeibors(-1, m_vSites[ iPos - 1 ] );
-                m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos - 1 ],  Site::WEST_UP );
-                m_vSites[ iPos ]->set1stNeibors(-1, m_vSites[ iPos + m_iSizeX + 1 ] );
-                m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos + m_iSizeX  + 1 ],  Site::EAST_DOWN );
-                m_vSites[ iPos ]->set1stNeibors(-1, m_vSites[ iPos + m_iSizeX  - 1 ] );
-                m_vSites[ iPos ]->setNeighPosition( m_vSites[ iPos + m_iSizeX  - 1 ],  Site::WEST_DOWN );
-            }
-
-        }
-    }
-
-    //Mark the corners. Helps to define the rest of the neighours
-    // N1, N5 ---- N6, N2
-    // |                |
-    // |                |
-    // N3, N8 ---- N7, N4
-
-    // In the 6x6 example lattice (see above):
-    // N1 = 0, N2 = 5, N3 = 30, N4 = 35
-    // N5 = 1, N6 = 4, N7 = 34, N8 = 31
-
-    int N1 = 0, N2 = m_iSizeX - 1, N3 = getSize() - m_iSizeX, N4 = getSize() - 1;
-    int N5 = 1, N6 = N2 - 1, N7 = N4 - 1, N8 = N3 + 1;
-
-    //N1
-    m_vSites[ N1 ]->set1stNeibors(0, m_vSites[ 2 ] );
-    m_vSites[ N1 ]->setNeighPosition( m_vSites[ 2 ],  Site::EAST );
-    m_vSites[ N1 ]->set1stNeibors(0, m_vSites[ N2 - 1 ] );
-    m_vSites[ N1 ]->setNeighPosition( m_vSites[ N2 - 1 ],  Site::WEST );
-    m_vSites[ N1 ]->set1stNeibors(0, m_vSites[ m_iSizeX ] );
-    m_vSites[ N1 ]->setNeighPosition( m_vSites[ iPos + m_iSizeX ],  Site::SOUTH );
-    m_vSites[ N1 ]->set1stNeibors(0, m_vSites[ getSize() - m_iSizeX ] );
-    m_vSites[ N1 ]->setNeighPosition( m_vSites[ iPos + m_iSizeX ],  Site::NORTH );
-    m_vSites[ N1 ]->set1stNeibors( -1, m_vSites[ N1 + 1 ] );
-    m_vSites[ N1 ]->setNeighPosition( m_vSites[ N1 + 1 ],  Site::EAST_DOWN );
-    m_vSites[ N1 ]->set1stNeibors( -1, m_vSites[ N3 + 1 ] );
-    m_vSites[ N1 ]->setNeighPosition( m_vSites[ N3 + 1 ],  Site::EAST_UP );
-    m_vSites[ N1 ]->set1stNeibors( -1, m_vSites[ N2 ] );
-    m_vSites[ N1 ]->setNeighPosition( m_vSites[ N2 ],  Site::WEST_DOWN );
-    m_vSites[ N1 ]->set1stNeibors( -1, m_vSites[ N4 ] );
-    m_vSites[ N1 ]->setNeighPosition( m_vSites[ N4 ],  Site::WEST_UP );
-
-    //N2
-    m_vSites[ N2 ]->set1stNeibors(0, m_vSites[ N2 - 2 ] );
-    m_vSites[ N2 ]->setNeighPosition( m_vSites[ N2 - 2 ],  Site::WEST );
-    m_vSites[ N2 ]->set1stNeibors(0, m_vSites[ N1 + 1 ] );
-    m_vSites[ N2 ]->setNeighPosition( m_vSites[ N1 + 1 ],  Site::EAST );
-    m_vSites[ N2 ]->set1stNeibors(0, m_vSites[ N4 ] );
-    m_vSites[ N2 ]->setNeighPosition( m_vSites[ N4 ],  Site::NORTH );
-    m_vSites[ N2 ]->set1stNeibors(0, m_vSites[ N2 + m_iSizeX ] );
-    m_vSites[ N2 ]->setNeighPosition( m_vSites[ N2 + m_iSizeX ],  Site::SOUTH );
-    m_vSites[ N2 ]->set1stNeibors( -1, m_vSites[ N2 - 1 ] );
-    m_vSites[ N2 ]->setNeighPosition( m_vSites[ N2 - 1 ],  Site::WEST_UP );
-    m_vSites[ N2 ]->set1stNeibors( -1, m_vSites[ N2 + m_iSizeX - 1 ] );
-    m_vSites[ N2 ]->setNeighPosition( m_vSites[ N2 + m_iSizeX - 1 ],  Site::WEST_DOWN );
-    m_vSites[ N2 ]->set1stNeibors( -1, m_vSites[ m_iSizeX ] );
-    m_vSites[ N2 ]->setNeighPosition( m_vSites[ m_iSizeX ],  Site::EAST_DOWN );
-    m_vSites[ N2 ]->set1stNeibors( -1, m_vSites[ N1 ] );
-    m_vSites[ N2 ]->setNeighPosition( m_vSites[ N1 ],  Site::EAST_UP );
-
-    //N3
-    m_vSites[ N3 ]->set1stNeibors(0, m_vSites[ N3 + 2 ] );
-    m_vSites[ N3 ]->setNeighPosition( m_vSites[ N3 + 2 ],  Site::EAST );
-    m_vSites[ N3 ]->set1stNeibors(0, m_vSites[ N4 - 1 ] );
-    m_vSites[ N3 ]->setNeighPosition( m_vSites[ N4 - 1 ],  Site::WEST );
-    m_vSites[ N3 ]->set1stNeibors(0, m_vSites[ N1 ] );
-    m_vSites[ N3 ]->setNeighPosition( m_vSites[ N1 ],  Site::SOUTH );
-    m_vSites[ N3 ]->set1stNeibors(0, m_vSites[ N3 - m_iSizeX ] );
-    m_vSites[ N3 ]->setNeighPosition( m_vSites[ N3 - m_iSizeX ],  Site::NORTH );
-    m_vSites[ N3 ]->set1stNeibors( -1, m_vSites[ N3 - m_iSizeX + 1 ] );
-    m_vSites[ N3 ]->setNeighPosition( m_vSites[ N3 - m_iSizeX + 1 ],  Site::EAST_UP );
-    m_vSites[ N3 ]->set1stNeibors( -1, m_vSites[ N3 + 1 ] );
-    m_vSites[ N3 ]->setNeighPosition( m_vSites[ N3 + 1 ],  Site::EAST_DOWN );
-    m_vSites[ N3 ]->set1stNeibors( -1, m_vSites[ N4 ] );
-    m_vSites[ N3 ]->setNeighPosition( m_vSites[ N4 ],  Site::WEST_DOWN );
-    m_vSites[ N3 ]->set1stNeibors( -1, m_vSites[ N3 - 1 ] );
-    m_vSites[ N3 ]->setNeighPosition( m_vSites[ N3 - 1 ],  Site::WEST_UP );
-
-    //N4
-    m_vSites[ N4 ]->set1stNeibors(0, m_vSites[ N3 + 1 ] );
-    m_vSites[ N4 ]->setNeighPosition( m_vSites[ N3 + 1 ],  Site::EAST );
-    m_vSites[ N4 ]->set1stNeibors(0, m_vSites[ N4 - 2 ] );
-    m_vSites[ N4 ]->setNeighPosition( m_vSites[ N4 - 2 ],  Site::WEST );
-    m_vSites[ N4 ]->set1stNeibors(0, m_vSites[ N2 ] );
-    m_vSites[ N4 ]->setNeighPosition( m_vSites[ N2 ],  Site::SOUTH );
-    m_vSites[ N4 ]->set1stNeibors(0, m_vSites[ N4 - m_iSizeX ] );
-    m_vSites[ N4 ]->setNeighPosition( m_vSites[ N4 - m_iSizeX  ],  Site::NORTH );
-    m_vSites[ N4 ]->set1stNeibors( -1, m_vSites[ N3 ] );
-    m_vSites[ N4 ]->setNeighPosition( m_vSites[ N3 ],  Site::WEST_UP );
-    m_vSites[ N4 ]->set1stNeibors( -1, m_vSites[ N6 ] );
-    m_vSites[ N4 ]->setNeighPosition( m_vSites[ N6 ],  Site::WEST_DOWN );
-    m_vSites[ N4 ]->set1stNeibors( -1, m_vSites[ N4 - 1 ] );
-    m_vSites[ N4 ]->setNeighPosition( m_vSites[ N4 - 1 ],  Site::EAST_UP );
-    m_vSites[ N4 ]->set1stNeibors( -1, m_vSites[ N1 ] );
-    m_vSites[ N4 ]->setNeighPosition( m_vSites[ N1 ],  Site::EAST_DOWN );
-
-    //N5
-    m_vSites[ N5 ]->set1stNeibors(0, m_vSites[ N5 + 2 ] );
-    m_vSites[ N5 ]->setNeighPosition( m_vSites[ N5 + 2 ],  Site::EAST );
-    m_vSites[ N5 ]->set1stNeibors(0, m_vSites[ N4 - 2 ] );
-    m_vSites[ N5 ]->setNeighPosition( m_vSites[ N4 - 2 ],  Site::WEST );
-    m_vSites[ N5 ]->set1stNeibors(0, m_vSites[ N3 + 1 ] );
-    m_vSites[ N5 ]->setNeighPosition( m_vSites[ N3 + 1 ],  Site::NORTH );
-    m_vSites[ N5 ]->set1stNeibors(0, m_vSites[ N5 + m_iSizeX ] );
-    m_vSites[ N5 ]->setNeighPosition( m_vSites[ N5 + m_iSizeX  ],  Site::SOUTH );
-    m_vSites[ N5 ]->set1stNeibors( -1, m_vSites[ N5 - 1 ] );
-    m_vSites[ N5 ]->setNeighPosition( m_vSites[ N5 - 1 ],  Site::WEST_UP );
-    m_vSites[ N5 ]->set1stNeibors( -1, m_vSites[ N2 + 1 ] );
-    m_vSites[ N5 ]->setNeighPosition( m_vSites[ N2 + 1 ],  Site::WEST_DOWN );
-    m_vSites[ N5 ]->set1stNeibors( -1, m_vSites[ N5 + 1 ] );
-    m_vSites[ N5 ]->setNeighPosition( m_vSites[ N5 + 1 ],  Site::EAST_UP );
-    m_vSites[ N5 ]->set1stNeibors( -1, m_vSites[ N5 + m_iSizeX + 1] );
-    m_vSites[ N5 ]->setNeighPosition( m_vSites[ N5 + m_iSizeX + 1 ],  Site::EAST_DOWN );
-
-    //N6
-    m_vSites[ N6 ]->set1stNeibors(0, m_vSites[ N1 ] );
-    m_vSites[ N6 ]->setNeighPosition( m_vSites[ N1 ],  Site::EAST );
-    m_vSites[ N6 ]->set1stNeibors(0, m_vSites[ N6 - 2 ] );
-    m_vSites[ N6 ]->setNeighPosition( m_vSites[ N6 - 2 ],  Site::WEST );
-    m_vSites[ N6 ]->set1stNeibors(0, m_vSites[ N7 ] );
-    m_vSites[ N6 ]->setNeighPosition( m_vSites[ N7 ],  Site::NORTH );
-    m_vSites[ N6 ]->set1stNeibors(0, m_vSites[ N6 + m_iSizeX ] );
-    m_vSites[ N6 ]->setNeighPosition( m_vSites[ N6 + m_iSizeX  ],  Site::SOUTH );
-    m_vSites[ N6 ]->set1stNeibors( -1, m_vSites[ N7 - 1 ] );
-    m_vSites[ N6 ]->setNeighPosition( m_vSites[ N7 - 1 ],  Site::WEST_UP );
-    m_vSites[ N6 ]->set1stNeibors( -1, m_vSites[ N6 - 1 ] );
-    m_vSites[ N6 ]->setNeighPosition( m_vSites[ N6 - 1 ],  Site::WEST_DOWN );
-    m_vSites[ N6 ]->set1stNeibors( -1, m_vSites[ N4 ] );
-    m_vSites[ N6 ]->setNeighPosition( m_vSites[ N4 ],  Site::EAST_UP );
-    m_vSites[ N6 ]->set1stNeibors( -1, m_vSites[ N2 ] );
-    m_vSites[ N6 ]->setNeighPosition( m_vSites[ N2 ],  Site::EAST_DOWN );
-
-    //N7
-    m_vSites[ N7 ]->set1stNeibors(0, m_vSites[ N3 ] );
-    m_vSites[ N7 ]->setNeighPosition( m_vSites[ N3 ],  Site::EAST );
-    m_vSites[ N7 ]->set1stNeibors(0, m_vSites[ N7 - 2 ] );
-    m_vSites[ N7 ]->setNeighPosition( m_vSites[ N7 - 2 ],  Site::WEST );
-    m_vSites[ N7 ]->set1stNeibors(0, m_vSites[ N7 - m_iSizeX ] );
-    m_vSites[ N7 ]->setNeighPosition( m_vSites[ N7 - m_iSizeX ],  Site::NORTH );
-    m_vSites[ N7 ]->set1stNeibors(0, m_vSites[ N6 ] );
-    m_vSites[ N7 ]->setNeighPosition( m_vSites[ N6  ],  Site::SOUTH );
-    m_vSites[ N7 ]->set1stNeibors( -1, m_vSites[ N7 - m_iSizeX - 1 ] );
-    m_vSites[ N7 ]->setNeighPosition( m_vSites[ N7 - m_iSizeX - 1 ],  Site::WEST_UP );
-    m_vSites[ N7 ]->set1stNeibors( -1, m_vSites[ N7 - 1 ] );
-    m_vSites[ N7 ]->setNeighPosition( m_vSites[ N7 - 1 ],  Site::WEST_DOWN );
-    m_vSites[ N7 ]->set1stNeibors( -1, m_vSites[ N7 - m_iSizeX + 1  ] );
-    m_vSites[ N7 ]->setNeighPosition( m_vSites[ N7 - m_iSizeX + 1  ],  Site::EAST_UP );
-    m_vSites[ N7 ]->set1stNeibors( -1, m_vSites[ N7 + 1 ] );
-    m_vSites[ N7 ]->setNeighPosition( m_vSites[ N7 + 1 ],  Site::EAST_DOWN );
-
-    //N8
-    m_vSites[ N8 ]->set1stNeibors(0, m_vSites[ N8 + 2 ] );
-    m_vSites[ N8 ]->setNeighPosition( m_vSites[ N8 + 2 ],  Site::EAST );
-    m_vSites[ N8 ]->set1stNeibors(0, m_vSites[ N4 ] );
-    m_vSites[ N8 ]->setNeighPosition( m_vSites[ N4 ],  Site::WEST );
-    m_vSites[ N8 ]->set1stNeibors(0, m_vSites[ N8 - m_iSizeX ] );
-    m_vSites[ N8 ]->setNeighPosition( m_vSites[ N8 - m_iSizeX ],  Site::NORTH );
-    m_vSites[ N8 ]->set1stNeibors(0, m_vSites[ N5 ] );
-    m_vSites[ N8 ]->setNeighPosition( m_vSites[ N5  ],  Site::SOUTH );
-    m_vSites[ N8 ]->set1stNeibors( -1, m_vSites[ N8 - 1 ] );
-    m_vSites[ N8 ]->setNeighPosition( m_vSites[ N8 - 1 ],  Site::WEST_UP );
-    m_vSites[ N8 ]->set1stNeibors( -1, m_vSites[ N1 ] );
-    m_vSites[ N8 ]->setNeighPosition( m_vSites[ N1 ],  Site::WEST_DOWN );
-    m_vSites[ N8 ]->set1stNeibors( -1, m_vSites[ N8 + 1  ] );
-    m_vSites[ N8 ]->setNeighPosition( m_vSites[ N8 + 1  ],  Site::EAST_UP );
-    m_vSites[ N8 ]->set1stNeibors( -1, m_vSites[ N5 + 1 ] );
-    m_vSites[ N8 ]->setNeighPosition( m_vSites[ N5 + 1 ],  Site::EAST_DOWN );
-
-
-    //first line
-    for (int i = 2; i < m_iSizeX-2; i++){
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2 ],  Site::WEST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ],  Site::EAST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + m_iSizeX ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX ],  Site::SOUTH );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ N3 + i ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ N3 + i ],  Site::NORTH );
-
-        if ( i%2 == 0){
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 1 ],  Site::WEST_DOWN );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 1 ],  Site::EAST_DOWN );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ N3 + i - 1] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ N3 + i - 1 ],  Site::WEST_UP );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ N3 + i + 1] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ N3 + i + 1 ],  Site::EAST_UP );
-        }
-        else {
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 1 ],  Site::WEST_UP );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 1 ],  Site::EAST_UP );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + m_iSizeX - 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX - 1  ],  Site::WEST_DOWN );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + m_iSizeX + 1] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX + 1 ],  Site::EAST_UP );
-        }
-    }
-
-    //last line
-    for (int i = (N8+1), iCount = 2; i < N7;  i++, iCount++){
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2 ],  Site::WEST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ],  Site::EAST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ N1 + iCount ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ N1 + iCount  ],  Site::SOUTH );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - m_iSizeX ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX ],  Site::NORTH );
-
-        if ( i%2 == 0){
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 1 ],  Site::WEST_DOWN );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 1 ],  Site::EAST_DOWN );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - m_iSizeX - 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX - 1 ],  Site::WEST_UP );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - m_iSizeX + 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX + 1 ],  Site::EAST_UP );
-        }
-        else {
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 1 ],  Site::WEST_UP );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 1 ],  Site::EAST_UP );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ iCount + 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ iCount + 1  ],  Site::WEST_DOWN );
-            m_vSites[ i ]->set1stNeibors( -1, m_vSites[ iCount - 1 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ iCount - 1 ],  Site::EAST_UP );
-        }
-    }
-
-    //First column
-    for (int i = ( N1 + m_iSizeX ); i < N3;  i += m_iSizeX ){
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + m_iSizeX - 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX - 2 ],  Site::WEST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ],  Site::EAST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + m_iSizeX ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX  ],  Site::SOUTH );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - m_iSizeX ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX ],  Site::NORTH );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - m_iSizeX + 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX + 1 ],  Site::EAST_UP );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 1 ],  Site::EAST_DOWN );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i  - 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 1 ],  Site::WEST_UP );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + m_iSizeX - 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX - 1 ],  Site::WEST_DOWN );
-    }
-
-    //Second column
-    for (int i = ( N5 + m_iSizeX ); i < N8;  i += m_iSizeX ){
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + m_iSizeX  - 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX  - 2 ],  Site::WEST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ],  Site::EAST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + m_iSizeX ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX  ],  Site::SOUTH );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - m_iSizeX ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX ],  Site::NORTH );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 1 ],  Site::EAST_UP );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + m_iSizeX + 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX + 1 ],  Site::EAST_DOWN );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 1 ],  Site::WEST_UP );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + m_iSizeX - 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX - 1 ],  Site::WEST_DOWN );
-    }
-
-
-    //Last column
-    for ( int i = (N2 + m_iSizeX); i < (getSize() - m_iSizeX); i+=m_iSizeX ){
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2 ],  Site::WEST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - m_iSizeX + 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX + 2 ],  Site::EAST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + m_iSizeX ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX  ],  Site::SOUTH );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - m_iSizeX ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX ],  Site::NORTH );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 1 ],  Site::WEST_UP );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + m_iSizeX - 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX - 1 ],  Site::WEST_DOWN );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 1 ],  Site::EAST_UP );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - m_iSizeX + 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX + 1 ],  Site::EAST_DOWN );
-    }
-
-    //Last column - 1
-    for ( int i = (N6 + m_iSizeX); i < N7; i+=m_iSizeX ){
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2 ],  Site::WEST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - m_iSizeX + 2 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX + 2 ],  Site::EAST );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i + m_iSizeX ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeX  ],  Site::SOUTH );
-        m_vSites[ i ]->set1stNeibors( 0, m_vSites[ i - m_iSizeX ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX ],  Site::NORTH );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - m_iSizeX - 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX - 1 ],  Site::WEST_UP );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 1 ],  Site::WEST_DOWN );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i - m_iSizeX + 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeX + 1 ],  Site::EAST_UP );
-        m_vSites[ i ]->set1stNeibors( -1, m_vSites[ i + 1 ] );
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 1 ],  Site::EAST_DOWN );
-    }
-
-    //A very simple test that all neighs have been defined at least in number
-    for ( int i = 0; i < getSize(); i++){
-        if ( m_vSites[ i ]->get1stNeihbors()[ 0 ].size() != 4 ){
-            cout << "Check level 0 neighs in site: " << i << endl;
-            EXIT
-        }
-
-        if ( m_vSites[ i ]->get1stNeihbors()[ 0 ].size() != 4 ){
-            cout << "Check level 0 neighs in site: " << i << endl;
-            EXIT
-        }
-    }
+    //The rows are in the y-direction and the columns in the x-direction
+    buildNeighbours< FCC110Stencil >( m_Neighbours, m_vSites, m_iSizeY, m_iSizeX );
 }
 
 void FCC::mf_neigh_111()
 {
-    /* All except the boundaries */
-    for ( int i = 2; i < m_iSizeX - 2; i++ ){
-        for (int j = (i*m_iSizeY + 2); j < (i*m_iSizeY + m_iSizeY - 2); j++ ){
-            m_vSites[ j]->setNeigh( m_vSites[ j - 2]);
-            m_vSites[ j]->setNeighPosition( m_vSites[ j - 2], Site::EAST);
-
-            m_vSites[ j]->setNeigh( m_vSites[ j + 2]);
-            m_vSites[ j]->setNeighPosition( m_vSites[ j + 2 ], Site::WEST);
-
-            m_vSites[ j]->setNeigh( m_vSites[ j + m_iSizeY - 1]);
-            m_vSites[ j]->setNeighPosition( m_vSites[ j + m_iSizeY - 1 ], Site::EAST_DOWN);
-
-            m_vSites[ j]->setNeigh( m_vSites[ j + m_iSizeY + 1 ]);
-            m_vSites[ j]->setNeighPosition( m_vSites[  j + m_iSizeY + 1 ], Site::WEST_DOWN);
-
-            m_vSites[ j]->setNeigh( m_vSites[ j - m_iSizeY - 1]);
-            m_vSites[ j]->setNeighPosition( m_vSites[ j - m_iSizeY - 1 ], Site::EAST_UP);
-
-            m_vSites[ j]->setNeigh( m_vSites[ j - m_iSizeY + 1]);
-            m_vSites[ j]->setNeighPosition( m_vSites[ j - m_iSizeY + 1 ], Site::WEST_UP);
-
-            //        m_vSites[ j]->storeActivationSite( m_vSites[ j - 1 ], Site::ACTV_EAST );
-            //       m_vSites[ j]->storeActivationSite( m_vSites[ j + 1], Site::ACTV_WEST );
-
-            //       m_vSites[ j]->storeActivationSite( m_vSites[ j + m_iSizeY ], Site::ACTV_SOUTH );
-            //       m_vSites[ j]->storeActivationSite( m_vSites[ j - m_iSizeY ], Site::ACTV_NORTH );
-
-            m_vSites[ j]->setNeighPosition( m_vSites[ j - 2*m_iSizeY  ], Site::NORTH);
-            m_vSites[ j]->setNeighPosition( m_vSites[ j + 2*m_iSizeY ], Site::SOUTH);
-        }
-    }
-
-    /* First row */
-    for ( int i = 0; i < m_iSizeY; i++){
-        /* First site */
-        if ( i == 0) {
-            m_vSites[ i ]->setNeigh( m_vSites[ 2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ 2], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ m_iSizeY-2]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ m_iSizeY-2], Site::WEST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ m_iSizeY+1]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ m_iSizeY+1], Site::EAST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ 2*m_iSizeY-1]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[  2*m_iSizeY-1], Site::WEST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize()-m_iSizeY+1]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[  getSize()-m_iSizeY+1], Site::EAST_UP);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize()-1]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[  getSize()-1], Site::WEST_UP);
-
-            m_vSites[ i ]->setNeighPosition( m_vSites[  getSize() - 2*m_iSizeY], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition( m_vSites[  2*m_iSizeY ], Site::SOUTH);
-        }
-        /* Second site */
-        else if ( i == 1){
-            m_vSites[ i ]->setNeigh( m_vSites[ 3]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ 3], Site::WEST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ m_iSizeY - 1]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ m_iSizeY - 1], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ m_iSizeY]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ m_iSizeY], Site::EAST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ m_iSizeY + 2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ m_iSizeY + 2], Site::WEST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize() - m_iSizeY]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ getSize() - m_iSizeY], Site::EAST_UP);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize() -m_iSizeY + 2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ getSize() - m_iSizeY + 2], Site::WEST_UP);
-
-            m_vSites[ i ]->setNeighPosition(m_vSites[ getSize() - 2*m_iSizeY + 1], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ 2*m_iSizeY + 1 ], Site::SOUTH);
-        }
-        /* Before last site */
-        else if (i == m_iSizeY - 2){
-            m_vSites[ i ]->setNeigh( m_vSites[ 0]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ 0], Site::WEST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ m_iSizeY-4]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ m_iSizeY-4], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ 2*m_iSizeY -3]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ 2*m_iSizeY -3], Site::EAST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ 2*m_iSizeY -1]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ 2*m_iSizeY -1], Site::WEST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize() -1]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[  getSize() -1], Site::WEST_UP);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize() -3]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ getSize() -3], Site::EAST_UP);
-
-            m_vSites[ i ]->setNeighPosition(m_vSites[ getSize() - m_iSizeY - 2], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ 3*m_iSizeY - 2], Site::SOUTH);
-        }
-        /* End site */
-        else if( i == m_iSizeY-1){
-            m_vSites[ i ]->setNeigh( m_vSites[ 1]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ 1], Site::WEST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ m_iSizeY-3]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ m_iSizeY-3], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ m_iSizeY]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ m_iSizeY], Site::WEST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ 2*m_iSizeY - 2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ 2*m_iSizeY - 2], Site::EAST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize()-m_iSizeY]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ getSize()-m_iSizeY], Site::WEST_UP);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize()-2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ getSize()-2], Site::EAST_UP);
-
-            m_vSites[ i ]->setNeighPosition(m_vSites[ getSize() - m_iSizeY - 1], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ 3*m_iSizeY - 1], Site::SOUTH);
-        }
-        else {
-            m_vSites[ i ]->setNeigh( m_vSites[ i+m_iSizeY-1]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i + m_iSizeY - 1], Site::EAST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i+m_iSizeY+1]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i+m_iSizeY+1], Site::WEST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i-2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i-2], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i+2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i+2], Site::WEST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i+getSize()-m_iSizeY-1]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i+getSize()-m_iSizeY-1], Site::EAST_UP);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i+getSize()-m_iSizeY+1]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i+getSize()-m_iSizeY+1], Site::WEST_UP);
-
-            m_vSites[ i ]->setNeighPosition(m_vSites[ getSize() - 2*m_iSizeY + i], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i + 2*m_iSizeY ], Site::SOUTH);        }
-    }
-
-    /* Last row */
-    for ( int i = (getSize() - m_iSizeY); i < getSize(); i++ ){
-        if ( i == ( getSize() - m_iSizeY ) ){ //bottom left site
-            m_vSites[ i ]->setNeigh( m_vSites[ m_iSizeY - 1] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ m_iSizeY - 1 ], Site::EAST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ 1]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ 1], Site::WEST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i + 2]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2], Site::WEST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize() - 2 ]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ getSize() - 2 ], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i - 1]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 1], Site::EAST_UP);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 1]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 1], Site::WEST_UP);
-
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2*m_iSizeY ], Site::NORTH );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ m_iSizeY ], Site::SOUTH );
-        }
-        else if ( i == ( getSize() - 1 ) ){ //bottom right site
-            m_vSites[ i ]->setNeigh( m_vSites[  m_iSizeY - 2 ] );
-            m_vSites[ i ]->setNeighPosition( m_vSites[  m_iSizeY - 2 ], Site::EAST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ 0]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ 0], Site::WEST_DOWN);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize() - m_iSizeY + 1]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ getSize() - m_iSizeY + 1], Site::WEST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i - 2 ]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2 ], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize() - m_iSizeY - 2]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ getSize() - m_iSizeY - 2], Site::EAST_UP);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ getSize() - 2*m_iSizeY ]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ getSize() - 2*m_iSizeY ], Site::WEST_UP);
-
-            m_vSites[ i ]->setNeighPosition( m_vSites[ getSize() - 2*m_iSizeY - 1 ], Site::NORTH );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ 2*m_iSizeY - 1  ], Site::SOUTH );
-        }
-        else{
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2*m_iSizeY ], Site::NORTH );
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - (m_iSizeX-2)*m_iSizeY ], Site::SOUTH );
-
-            if ( i == (getSize() - m_iSizeY + 1 ) ){
-                m_vSites[ i ]->setNeigh( m_vSites[ getSize() - 1 ]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ getSize() - 1 ], Site::EAST);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY - 1]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY - 1], Site::EAST_UP);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ 0]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[0], Site::EAST_DOWN);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i + 2 ]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ], Site::WEST);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 1 ]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 1 ], Site::WEST_UP);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - (m_iSizeX-1)*m_iSizeY + 1]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - (m_iSizeX-1)*m_iSizeY + 1 ], Site::WEST_DOWN);
-            }
-            else if ( i == getSize() - 2 ){
-                m_vSites[ i ]->setNeigh( m_vSites[ getSize() - m_iSizeY ]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ getSize() - m_iSizeY ], Site::WEST);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 1]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 1  ], Site::WEST_UP);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - (m_iSizeX-1)*m_iSizeY + 1 ]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - (m_iSizeX-1)*m_iSizeY + 1 ], Site::WEST_DOWN);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - 2 ]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2 ], Site::EAST);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY - 1]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY - 1], Site::EAST_UP);
-
-                m_vSites[ i ]->setNeigh( m_vSites[  i - (m_iSizeX-1)*m_iSizeY - 1]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - (m_iSizeX-1)*m_iSizeY - 1 ], Site::EAST_DOWN);
-            }
-            else{
-                m_vSites[ i ]->setNeigh( m_vSites[ i + 2 ]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ], Site::WEST);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 1]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 1 ], Site::WEST_UP);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - (m_iSizeX-1)*m_iSizeY + 1]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - (m_iSizeX-1)*m_iSizeY + 1 ], Site::WEST_DOWN);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - 2 ]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2 ], Site::EAST);
-
-                m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY - 1]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY - 1], Site::EAST_UP);
-
-                m_vSites[ i ]->setNeigh( m_vSites[  i - (m_iSizeX-1)*m_iSizeY - 1]);
-                m_vSites[ i ]->setNeighPosition( m_vSites[ i - (m_iSizeX-1)*m_iSizeY - 1 ], Site::EAST_DOWN);
-            }
-        }
-    }
-
-    /* First East column */
-    for (int i = m_iSizeY; i < (getSize() - m_iSizeY); i+= m_iSizeY ){
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY - 2]);
-        m_vSites[ i ]->setNeighPosition(m_vSites[ i + m_iSizeY - 2], Site::EAST);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + 2]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2], Site::WEST);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + 2*m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2*m_iSizeY - 1 ], Site::EAST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY + 1 ]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[  i + m_iSizeY + 1 ], Site::WEST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 1 ], Site::EAST_UP);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 1 ], Site::WEST_UP);
-
-        if ( i == m_iSizeY ){
-            m_vSites[ i ]->setNeighPosition( m_vSites[ getSize() - m_iSizeY ], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2*m_iSizeY ], Site::SOUTH);
-        }
-        else if ( i == getSize() - 2*m_iSizeY ){
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2*m_iSizeY ], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ 0 ], Site::SOUTH);
-        }
-        else{
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2*m_iSizeY ], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2*m_iSizeY ], Site::SOUTH);
-        }
-    }
-
-    /* First West column side */
-    for (int i = (2*m_iSizeY -1); i < (getSize() - m_iSizeY); i+= m_iSizeY ){
-        m_vSites[ i ]->setNeigh( m_vSites[ i - 2]);
-        m_vSites[ i ]->setNeighPosition(m_vSites[ i - 2], Site::EAST);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY +  2]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY +  2 ], Site::WEST);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeY - 1 ], Site::EAST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + 1 ]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[  i + 1 ], Site::WEST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i -m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i -m_iSizeY - 1 ], Site::EAST_UP);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - 2*m_iSizeY + 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2*m_iSizeY + 1 ], Site::WEST_UP);
-
-        if ( i == 2*m_iSizeY - 1 ){
-            m_vSites[ i ]->setNeighPosition( m_vSites[ getSize() - 1 ], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2*m_iSizeY ], Site::SOUTH);
-        }
-        else if ( i == getSize() - m_iSizeY - 1 ){
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2*m_iSizeY ], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ m_iSizeY - 1 ], Site::SOUTH);
-        }
-        else{
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2*m_iSizeY ], Site::NORTH);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2*m_iSizeY ], Site::SOUTH);
-        }
-    }
-
-    /* Second row */
-    for ( int i = (m_iSizeY + 1); i < (2*m_iSizeY - 1); i++){
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeY - 1 ], Site::EAST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY + 1 ]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[  i + m_iSizeY + 1 ], Site::WEST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY - 1 ], Site::EAST_UP);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 1 ], Site::WEST_UP);
-
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + (m_iSizeX - 2)*m_iSizeY ], Site::NORTH);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2*m_iSizeY ], Site::SOUTH);
-
-        if ( i == (m_iSizeY + 1)  ){
-            m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY - 2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i + m_iSizeY - 2], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i + 2]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ], Site::WEST);
-        }
-        else if ( i == 2*m_iSizeY - 2 ){
-            m_vSites[ i ]->setNeigh( m_vSites[ i - 2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i - 2], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 2]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 2 ], Site::WEST);
-        }
-        else{
-            m_vSites[ i ]->setNeigh( m_vSites[ i - 2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i - 2], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i + 2]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ], Site::WEST);
-        }
-    }
-
-    /* Second before end row */
-    for ( int i = ( getSize() - 2*m_iSizeY + 1 ); i < (getSize() - m_iSizeY - 1); i++){
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeY - 1 ], Site::EAST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY + 1 ]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[  i + m_iSizeY + 1 ], Site::WEST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY - 1 ], Site::EAST_UP);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 1 ], Site::WEST_UP);
-
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2*m_iSizeY  ], Site::NORTH);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - (m_iSizeX - 2)*m_iSizeY ], Site::SOUTH);
-
-        if ( i == ( getSize() - 2*m_iSizeY + 1 )  ){
-            m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY - 2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i + m_iSizeY - 2], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i + 2]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ], Site::WEST);
-        }
-        else if ( i == getSize() - m_iSizeY - 2 ){
-            m_vSites[ i ]->setNeigh( m_vSites[ i - 2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i - 2], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 2]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 2 ], Site::WEST);
-        }
-        else{
-            m_vSites[ i ]->setNeigh( m_vSites[ i - 2]);
-            m_vSites[ i ]->setNeighPosition(m_vSites[ i - 2], Site::EAST);
-
-            m_vSites[ i ]->setNeigh( m_vSites[ i + 2]);
-            m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ], Site::WEST);
-        }
-    }
-
-    /* Second east column */
-    /* Since we have defined the corners in the "second row" and in the "second before end row" no extra action is needed - No ifs...*/
-    for ( int i = ( 2*m_iSizeY + 1 ); i < ( (m_iSizeX-3)*m_iSizeY + 2 ); i+=m_iSizeY){
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY - 2]);
-        m_vSites[ i ]->setNeighPosition(m_vSites[ i + m_iSizeY - 2], Site::EAST);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + 2]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2 ], Site::WEST);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeY - 1 ], Site::EAST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY + 1 ]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[  i + m_iSizeY + 1 ], Site::WEST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY - 1 ], Site::EAST_UP);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 1 ], Site::WEST_UP);
-
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2*m_iSizeY  ], Site::NORTH);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2*m_iSizeY ], Site::SOUTH);
-    }
-
-    /* Second west column */
-    /* Since we have defined the corners in the "second row" and in the "second before end row" no extra action is needed - No ifs...*/
-    for ( int i = (3*m_iSizeY - 2) ; i < ( (m_iSizeX-1)*m_iSizeY - 2 ); i+=m_iSizeY){
-        m_vSites[ i ]->setNeigh( m_vSites[ i - 2]);
-        m_vSites[ i ]->setNeighPosition(m_vSites[ i - 2], Site::EAST);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 2]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 2 ], Site::WEST);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + m_iSizeY - 1 ], Site::EAST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i + m_iSizeY + 1 ]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[  i + m_iSizeY + 1 ], Site::WEST_DOWN);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY - 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY - 1 ], Site::EAST_UP);
-
-        m_vSites[ i ]->setNeigh( m_vSites[ i - m_iSizeY + 1]);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - m_iSizeY + 1 ], Site::WEST_UP);
-
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i - 2*m_iSizeY  ], Site::NORTH);
-        m_vSites[ i ]->setNeighPosition( m_vSites[ i + 2*m_iSizeY ], Site::SOUTH);
-    }
+    //The rows are in the x-direction and the columns in the y-direction
+    buildNeighbours< FCC111Stencil >( m_Neighbours, m_vSites, m_iSizeX, m_iSizeY );
 }
 
 int FCC::calculateNeighNum( int id,  const int level )
 {
     int neighs = 0;
-    vector<Site* > sites = m_vSites[ id ]->get1stNeihbors()[ level ];
+    NeighbourSpan sites = getSite( id )->get1stNeihbors( level );
 
     switch (level){
     case -1:
         for ( Site* s:sites) {
-            if ( s->getHeight() == m_vSites[ id ]->getHeight() - 1 ){
+            if ( s->getHeight() == getSite( id )->getHeight() - 1 ){
                 cout << s->getID() << " " << s->getHeight()  << endl;
                 neighs++;
             }
@@ -988,7 +159,7 @@ int FCC::calculateNeighNum( int id,  const int level )
         break;
     case 0:
         for ( Site* s:sites ) {
-            if ( s->getHeight() == m_vSites[ id ]->getHeight() )
+            if ( s->getHeight() == getSite( id )->getHeight() )
                 neighs++;
         }
         break;
@@ -1010,22 +181,22 @@ int FCC::calculateNeighNum( int id,  const int level )
     for (int i = 0; i < m_lattice->getY(); i++){
         for (int j = 0; j < m_lattice->getX(); j++){
             //Count the atoms as you pass ...
-            if ( m_lattice->getSite( i*m_lattice->getX() + j )->getHeight()%2 == 0 )
-                iCountAtoms += m_lattice->getSite( i*m_lattice->getX() + j )->getHeight()/2;
+            if ( m_lattice->getSite( i, j )->getHeight()%2 == 0 )
+                iCountAtoms += m_lattice->getSite( i, j )->getHeight()/2;
             else
-                iCountAtoms += (m_lattice->getSite( i*m_lattice->getX() + j )->getHeight()+1)/2;
-            if ( m_lattice->getSite( i*m_lattice->getX() + j )->getHeight() > iMaxH )
-                iMaxH = m_lattice->getSite( i*m_lattice->getX() + j )->getHeight();
+                iCountAtoms += (m_lattice->getSite( i, j )->getHeight()+1)/2;
+            if ( m_lattice->getSite( i, j )->getHeight() > iMaxH )
+                iMaxH = m_lattice->getSite( i, j )->getHeight();
         }
     }
     file << iCountAtoms << endl;
     file << endl;
     for (int i = 0; i < m_lattice->getY(); i++){
         for (int j = 0; j < m_lattice->getX(); j++){
-        for ( int k = 0; k < m_lattice->getSite( i*m_lattice->getX() + j )->getHeight(); k+=2){
-                int max = m_lattice->getSite(i*m_lattice->getX() + j)->getHeight()-1;
+        for ( int k = 0; k < m_lattice->getSite( i, j )->getHeight(); k+=2){
+                int max = m_lattice->getSite( i, j )->getHeight()-1;
                 if ( k%2 == 0){
-                    if ( m_lattice->getSite(i*m_lattice->getX() + j)->getLabel() == "HAMD" ) {
+                    if ( m_lattice->getSite( i, j )->getLabel() == "HAMD" ) {
                         if ( k != max  )
                             file << "Cu" << " " << x << " "  <<  y  << " " << h << endl;
                         else if ( k == max )
@@ -1036,7 +207,7 @@ int FCC::calculateNeighNum( int id,  const int level )
                     h = h + a;
                 }
                 else {
-                    if ( m_lattice->getSite(i*m_lattice->getX() + j)->getLabel() == "HAMD" ) {
+                    if ( m_lattice->getSite( i, j )->getLabel() == "HAMD" ) {
                         if ( k != max  )
                             file << "C" << " " << x1 << " "  <<  y1  << " " << h1 << endl;
                         else if ( k == max )
@@ -1077,13 +248,13 @@ void FCC::writeXYZ( string filename )
         for (int j = 0; j < m_lattice->getX(); j++){
             //Count the atoms as you pass ...
 
-            if ( m_lattice->getSite( i*m_lattice->getX() + j )->getHeight()%2 == 0 )
-                iCountAtoms += m_lattice->getSite( i*m_lattice->getX() + j )->getHeight()/2;
+            if ( m_lattice->getSite( i, j )->getHeight()%2 == 0 )
+                iCountAtoms += m_lattice->getSite( i, j )->getHeight()/2;
             else
-                iCountAtoms += (m_lattice->getSite( i*m_lattice->getX() + j )->getHeight()+1)/2;
+                iCountAtoms += (m_lattice->getSite( i, j )->getHeight()+1)/2;
 
-            if ( m_lattice->getSite( i*m_lattice->getX() + j )->getHeight() > iMaxH )
-                iMaxH = m_lattice->getSite( i*m_lattice->getX() + j )->getHeight();
+            if ( m_lattice->getSite( i, j )->getHeight() > iMaxH )
+                iMaxH = m_lattice->getSite( i, j )->getHeight();
         }
     }
 
@@ -1094,14 +265,14 @@ void FCC::writeXYZ( string filename )
         for (int j = 0; j < m_lattice->getX(); j++){
 
 
-            if (  m_lattice->getSite( i*m_lattice->getX() + j )->getHeight()%2 != 0 ){
+            if (  m_lattice->getSite( i, j )->getHeight()%2 != 0 ){
 
-                int max = m_lattice->getSite( i*m_lattice->getX() + j )->getHeight() - 1;
+                int max = m_lattice->getSite( i, j )->getHeight() - 1;
 
-                for ( int k = 0; k < m_lattice->getSite( i*m_lattice->getX() + j )->getHeight(); k+=2){
+                for ( int k = 0; k < m_lattice->getSite( i, j )->getHeight(); k+=2){
  //                   file << "Cu" << " " << x << " "  <<  y  << " " << h << endl;
 
-                    if ( m_lattice->getSite(i*m_lattice->getX() + j)->getLabel() == "HAMD" ) {
+                    if ( m_lattice->getSite( i, j )->getLabel() == "HAMD" ) {
                         if ( k != max  )
                             file << "Cu" << " " << x << " "  <<  y  << " " << h << endl;
                         else if ( k == max )
@@ -1119,12 +290,12 @@ void FCC::writeXYZ( string filename )
             else
             {
 
-                int max = m_lattice->getSite( i*m_lattice->getX() + j )->getHeight() - 1;
+                int max = m_lattice->getSite( i, j )->getHeight() - 1;
 
-                for ( int k = 1; k < m_lattice->getSite( i*m_lattice->getX() + j )->getHeight(); k+=2){
+                for ( int k = 1; k < m_lattice->getSite( i, j )->getHeight(); k+=2){
 //                    file << "C" << " " << x1 << " "  <<  y1  << " " << h1 << endl;
 
-                    if ( m_lattice->getSite(i*m_lattice->getX() + j)->getLabel() == "HAMD" ) {
+                    if ( m_lattice->getSite( i, j )->getLabel() == "HAMD" ) {
                         if ( k != max )
                             file << "C" << " " << x1 << " "  <<  y1  << " " << h1 << endl;
                         else if ( k == max )
@@ -1172,4 +343,13 @@ void FCC::check()
     cout << "Activation: " << endl;
 }
 
-unordered_map<string, double> FCC::computeCoverages( vector<string> species){ }
+NeighbourCounter FCC::getNeighbourCounter()
+{
+    if ( m_sOrient == "111" )
+        return &countNeighbours< FCC111Stencil >;
+    else if ( m_sOrient == "110" )
+        return &countNeighbours< FCC110Stencil >;
+
+    return Lattice::getNeighbourCounter();
+}
+
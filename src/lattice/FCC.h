@@ -64,7 +64,7 @@ public:
 
     void buildSteps(int, int);
 
-    unordered_map<string, double > computeCoverages( vector<string> species ) override;
+    NeighbourCounter getNeighbourCounter() override;
 
 protected:
     /// Build the first neighbours for the FCC(100) lattice.
@@ -69,10 +69,10 @@ public:
 
     inline bool isStepped() { return m_bHasSteps; }
 
-    unordered_map<string, double> computeCoverages(vector<string> species) override;
+    NeighbourCounter getNeighbourCounter() override;
 
 protected:
-    /// Build the neighbours for the BCC lattice for each site.
+    /// Build the neighbours of each site from the stencil of the lattice.
     void mf_neigh();
 
     /// Build the neighbours of each site depending on the type of the.
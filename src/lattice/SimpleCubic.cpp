@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "SimpleCubic.h"
+#include "stencil.h"
 
 #include <map>
 
@@ -51,9 +52,6 @@ void SimpleCubic::buildSteps()
         iStep++;
     }
 
-    for ( int i = 0; i< m_vSites.size(); i++)
-        calculateNeighNum( i );
-
     int h = getSite( m_iSizeY-1, m_iSizeX-1)->getHeight() ;
     m_iStepDiff = abs( getSite( m_iSizeY-1, m_iSizeX-1)->getHeight() - getSite( 0, 0 )->getHeight() ) + 1;
 
@@ -85,21 +83,19 @@ void SimpleCubic::build()
     }
 
     // The sites of the lattice.
-    m_vSites.resize( getSize() );
-    for (int i = 0; i < m_vSites.size(); i++)
-        m_vSites[i] = new Site();
+    mf_allocateSites();
 
     //This is OK
     for (int i = 0; i < m_iSizeX; i++)
     {
         for (int j = i * m_iSizeY; j < (m_iSizeY + i * m_iSizeY); j++)
         {
-            m_vSites[j]->setID(j);
             m_vSites[j]->setHeight(m_iHeight);
         }
     }
 
     mf_neigh();
+    m_Neighbours.compress();
 
     // Here we set the label of the species
     for (int i = 0; i < m_iSizeY; i++){
@@ -109,11 +105,7 @@ void SimpleCubic::build()
 
 }
 
-SimpleCubic::~SimpleCubic()
-{
-    for (int i = 0; i < getSize(); i++)
-        delete m_vSites[i];
-}
+SimpleCubic::~SimpleCubic(){}
 
 void SimpleCubic::setSteps(bool hasSteps)
 {
@@ -122,171 +114,8 @@ void SimpleCubic::setSteps(bool hasSteps)
 
 void SimpleCubic::mf_neigh()
 {
-    /* All except the boundaries */
-    for (int i = 1; i < m_iSizeY - 1; i++)
-    {
-        for (int j = 1; j < m_iSizeX - 1; j++)
-        {
-            m_vSites[i * m_iSizeX + j]->setNeigh(m_vSites[(i - 1) * m_iSizeX + j]);
-            m_vSites[i * m_iSizeX + j]->setNeighPosition(m_vSites[(i - 1) * m_iSizeX + j], Site::NORTH);
-
-            m_vSites[i * m_iSizeX + j]->setNeigh(m_vSites[(i + 1) * m_iSizeX + j]);
-            m_vSites[i * m_iSizeX + j]->setNeighPosition(m_vSites[(i + 1) * m_iSizeX + j], Site::SOUTH);
-
-            m_vSites[i * m_iSizeX + j]->setNeigh(m_vSites[i * m_iSizeX + j + 1]);
-            m_vSites[i * m_iSizeX + j]->setNeighPosition(m_vSites[i * m_iSizeX + j + 1], Site::EAST);
-
-            m_vSites[i * m_iSizeX + j]->setNeigh(m_vSites[i * m_iSizeX + j - 1]);
-            m_vSites[i * m_iSizeX + j]->setNeighPosition(m_vSites[i * m_iSizeX + j - 1], Site::WEST);
-        }
-    }
-
-    int iFirstCorner = 0;
-    int iSecondCorner = m_iSizeX - 1;
-    int iThirdCorner = m_iSizeX * m_iSizeY - m_iSizeX;
-    int iForthCorner = m_iSizeX * m_iSizeY - 1;
-
-    /*First row */
-    for (int j = iFirstCorner; j <= iSecondCorner; j++)
-    {
-        if (j != 0 && j != m_iSizeX - 1)
-        {
-            m_vSites[j]->setNeigh(m_vSites[j - 1]);
-            m_vSites[j]->setNeighPosition(m_vSites[j - 1], Site::WEST);
-
-            m_vSites[j]->setNeigh(m_vSites[j + 1]);
-            m_vSites[j]->setNeighPosition(m_vSites[j + 1], Site::EAST);
-
-            m_vSites[j]->setNeigh(m_vSites[j + m_iSizeX]);
-            m_vSites[j]->setNeighPosition(m_vSites[j + m_iSizeX], Site::SOUTH);
-
-            m_vSites[j]->setNeigh(m_vSites[iThirdCorner + j]);
-            m_vSites[j]->setNeighPosition(m_vSites[iThirdCorner + j], Site::NORTH);
-        }
-        else if (j == iFirstCorner)
-        {
-            m_vSites[j]->setNeigh(m_vSites[iSecondCorner]);
-            m_vSites[j]->setNeighPosition(m_vSites[iSecondCorner], Site::WEST);
-
-            m_vSites[j]->setNeigh(m_vSites[1]);
-            m_vSites[j]->setNeighPosition(m_vSites[1], Site::EAST);
-
-            m_vSites[j]->setNeigh(m_vSites[iSecondCorner + 1]);
-            m_vSites[j]->setNeighPosition(m_vSites[iSecondCorner + 1], Site::SOUTH);
-
-            m_vSites[j]->setNeigh(m_vSites[iThirdCorner]);
-            m_vSites[j]->setNeighPosition(m_vSites[iThirdCorner], Site::NORTH);
-        }
-        else if (j == iSecondCorner)
-        {
-            m_vSites[j]->setNeigh(m_vSites[j - 1]);
-            m_vSites[j]->setNeighPosition(m_vSites[j - 1], Site::WEST);
-
-            m_vSites[j]->setNeigh(m_vSites[0]);
-            m_vSites[j]->setNeighPosition(m_vSites[0], Site::EAST);
-
-            m_vSites[j]->setNeigh(m_vSites[2 * m_iSizeX - 1]);
-            m_vSites[j]->setNeighPosition(m_vSites[2 * m_iSizeX - 1], Site::SOUTH);
-
-            m_vSites[j]->setNeigh(m_vSites[iForthCorner]);
-            m_vSites[j]->setNeighPosition(m_vSites[iForthCorner], Site::NORTH);
-        }
-    }
-
-    /*Last row */
-    int iPos = 1;
-    for (int j = iThirdCorner; j <= iForthCorner; j++)
-    {
-        if (j != iThirdCorner && j != iForthCorner)
-        {
-            m_vSites[j]->setNeigh(m_vSites[j - 1]);
-            m_vSites[j]->setNeighPosition(m_vSites[j - 1], Site::WEST);
-
-            m_vSites[j]->setNeigh(m_vSites[j + 1]);
-            m_vSites[j]->setNeighPosition(m_vSites[j + 1], Site::EAST);
-
-            m_vSites[j]->setNeigh(m_vSites[iFirstCorner + iPos]);
-            m_vSites[j]->setNeighPosition(m_vSites[iFirstCorner + iPos], Site::SOUTH);
-
-            m_vSites[j]->setNeigh(m_vSites[j - m_iSizeX]);
-            m_vSites[j]->setNeighPosition(m_vSites[j - m_iSizeX], Site::NORTH);
-            iPos++;
-        }
-        else if (j == iThirdCorner)
-        {
-            m_vSites[j]->setNeigh(m_vSites[iForthCorner]);
-            m_vSites[j]->setNeighPosition(m_vSites[iForthCorner], Site::WEST);
-
-            m_vSites[j]->setNeigh(m_vSites[iThirdCorner + 1]);
-            m_vSites[j]->setNeighPosition(m_vSites[iThirdCorner + 1], Site::EAST);
-
-            m_vSites[j]->setNeigh(m_vSites[iFirstCorner]);
-            m_vSites[j]->setNeighPosition(m_vSites[iFirstCorner], Site::SOUTH);
-
-            m_vSites[j]->setNeigh(m_vSites[iThirdCorner - m_iSizeX]);
-            m_vSites[j]->setNeighPosition(m_vSites[iThirdCorner - m_iSizeX], Site::NORTH);
-        }
-        else if (j == iForthCorner)
-        {
-            m_vSites[j]->setNeigh(m_vSites[iForthCorner - 1]);
-            m_vSites[j]->setNeighPosition(m_vSites[iForthCorner - 1], Site::WEST);
-
-            m_vSites[j]->setNeigh(m_vSites[iThirdCorner]);
-            m_vSites[j]->setNeighPosition(m_vSites[iThirdCorner], Site::EAST);
-
-            m_vSites[j]->setNeigh(m_vSites[iSecondCorner]);
-            m_vSites[j]->setNeighPosition(m_vSites[iSecondCorner], Site::SOUTH);
-
-            m_vSites[j]->setNeigh(m_vSites[iThirdCorner - 1]);
-            m_vSites[j]->setNeighPosition(m_vSites[iThirdCorner - 1], Site::NORTH);
-        }
-    }
-
-    /* First column */
-    for (int j = iFirstCorner + m_iSizeX; j < iThirdCorner; j += m_iSizeX)
-    {
-        m_vSites[j]->setNeigh(m_vSites[j + m_iSizeX - 1]);
-        m_vSites[j]->setNeighPosition(m_vSites[j + m_iSizeX - 1], Site::WEST);
-
-        m_vSites[j]->setNeigh(m_vSites[j + 1]);
-        m_vSites[j]->setNeighPosition(m_vSites[j + 1], Site::EAST);
-
-        m_vSites[j]->setNeigh(m_vSites[j + m_iSizeX]);
-        m_vSites[j]->setNeighPosition(m_vSites[j + m_iSizeX], Site::SOUTH);
-
-        m_vSites[j]->setNeigh(m_vSites[j - m_iSizeX]);
-        m_vSites[j]->setNeighPosition(m_vSites[j - m_iSizeX], Site::NORTH);
-    }
-
-    /* Last column */
-    for (int j = iSecondCorner + m_iSizeX; j < iForthCorner; j += m_iSizeX)
-    {
-        m_vSites[j]->setNeigh(m_vSites[j - 1]);
-        m_vSites[j]->setNeighPosition(m_vSites[j - 1], Site::WEST);
-
-        m_vSites[j]->setNeigh(m_vSites[j - m_iSizeX + 1]);
-        m_vSites[j]->setNeighPosition(m_vSites[j - m_iSizeX + 1], Site::EAST);
-
-        m_vSites[j]->setNeigh(m_vSites[j + m_iSizeX]);
-        m_vSites[j]->setNeighPosition(m_vSites[j + m_iSizeX], Site::SOUTH);
-
-        m_vSites[j]->setNeigh(m_vSites[j - m_iSizeX]);
-        m_vSites[j]->setNeighPosition(m_vSites[j - m_iSizeX], Site::NORTH);
-    }
-
-    /*	int iCount = 0;
-    int pos = 0;
-    while (iCount < 100) {
-        cout << "Enter pos to print neighbours: ";
-        cin >> pos;
-        cout << m_vSites[pos]->getID() << ": " << endl;
-//		for (int i = 0; i < 4; i++) {
-            cout << "WEST: " << m_vSites[pos]->getNeighPosition( Site::WEST )->getID()  << endl;
-            cout << "EAST: " << m_vSites[pos]->getNeighPosition(Site::EAST)->getID() << endl;
-            cout << "NORTH: " << m_vSites[pos]->getNeighPosition(Site::NORTH)->getID() << endl;
-            cout << "SOUTH: " << m_vSites[pos]->getNeighPosition(Site::SOUTH)->getID() << endl;
-            //		}
-    }*/
+    //The rows are in the y-direction and the columns in the x-direction
+    buildNeighbours< SimpleCubicStencil >( m_Neighbours, m_vSites, m_iSizeY, m_iSizeX );
 }
 
 void SimpleCubic::check()
@@ -324,30 +153,9 @@ void SimpleCubic::writeLatticeHeights( double time, int step )
 
 int SimpleCubic::calculateNeighNum( int id )
 {
-    int neighs = 1;
-    for ( Site* s:m_vSites[ id ]->getNeighs() ) {
-        if ( s->getHeight() >= m_vSites[ id ]->getHeight() )
-            neighs++;
-    }
-
-    // THIS IS BAD! REFACTOR ....
-    m_vSites[ id ]->setNeighsNum( neighs );
-    return neighs;
+    //The coordination number of the site is kept by the lattice (see changeHeight)
+    return 1 + getSite( id )->getNeighsNum();
 }
 
-unordered_map<string, double> SimpleCubic::computeCoverages( vector<string> species ) {
-    for ( string name:species){
-        m_mCoverages[ name ] = 0.;
-
-        int iCount = 0;
-        for ( int i =0; i< getSize(); i++){
-            if ( m_vSites[ i ]->getLabel().compare( name ) == 0 )
-                iCount++;
-        }
-
-        m_mCoverages[ name ] = (double)iCount/getSize();
-    }
-
-    return m_mCoverages;
-}
+NeighbourCounter SimpleCubic::getNeighbourCounter(){ return &countNeighbours< SimpleCubicStencil >; }
 
@@ -16,8 +16,13 @@
 //============================================================================
 
 #include "lattice.h"
+#include "parameters.h"
+#include "stencil.h"
 
-Lattice::Lattice(Apothesis *apothesis) : Pointers(apothesis),m_iStepDiff(0)
+#include <algorithm>
+#include <cstdint>
+
+Lattice::Lattice(Apothesis *apothesis) : Pointers(apothesis),m_Ordering(ROW_MAJOR),m_fCountNeighs(nullptr),m_iSumHeights(0),m_iSumSquaredHeights(0),m_iSumHeightDiffs(0),m_bSymmetricNeighs(false),m_iStepDiff(0)
 {
 
 }
@@ -31,6 +36,8 @@ void Lattice::setType(string sType)
         m_Type = FCC;
     else if (sType == "SimpleCubic")
         m_Type = SimpleCubic;
+    else if (sType == "CoarseGrained")
+        m_Type = CoarseGrained;
     else
         m_Type = NONE;
 }
@@ -45,13 +52,228 @@ Lattice::~Lattice()
 {
 }
 
-vector<Site *> Lattice::getSites()
+void Lattice::copyFrom( Lattice* lattice )
+{
+    m_iSizeX = lattice->m_iSizeX;
+    m_iSizeY = lattice->m_iSizeY;
+    m_iHeight = lattice->m_iHeight;
+    m_hasSteps = lattice->m_hasSteps;
+    m_iNumSteps = lattice->m_iNumSteps;
+    m_iStepHeight = lattice->m_iStepHeight;
+    m_iStepDiff = lattice->m_iStepDiff;
+    m_sLabel = lattice->m_sLabel;
+
+    //The species are registered in the same order when the input is read so their IDs are the same in both lattices
+    m_Storage = lattice->m_Storage;
+    m_Storage.setSpeciesRegistry( &m_parameters->getSpeciesRegistry() );
+    m_Neighbours = lattice->m_Neighbours;
+    m_vSiteHandles = lattice->m_vSiteHandles;
+    m_Ordering = lattice->m_Ordering;
+    m_fCountNeighs = lattice->m_fCountNeighs;
+    m_iSumHeights = lattice->m_iSumHeights;
+    m_iSumSquaredHeights = lattice->m_iSumSquaredHeights;
+    m_iSumHeightDiffs = lattice->m_iSumHeightDiffs;
+    m_bSymmetricNeighs = lattice->m_bSymmetricNeighs;
+
+    //The handles are remapped by their ID and the sites keep their position in the lattice
+    vector<Site*> vHandles( m_vSiteHandles.size() );
+    for ( unsigned int i = 0; i < m_vSiteHandles.size(); i++ ){
+        vHandles[ i ] = &m_vSiteHandles[ i ];
+        vHandles[ i ]->setStorage( &m_Storage );
+        vHandles[ i ]->setNeighbourTable( &m_Neighbours );
+    }
+    m_Storage.setSites( m_vSiteHandles.data() );
+    m_Neighbours.setSites( m_vSiteHandles.data() );
+
+    for ( Site* s:vHandles )
+        s->remap( vHandles );
+
+    m_vSites.resize( lattice->m_vSites.size() );
+    for ( unsigned int i = 0; i < m_vSites.size(); i++ )
+        m_vSites[ i ] = vHandles[ lattice->m_vSites[ i ]->getID() ];
+}
+
+void Lattice::mf_allocateSites()
+{
+    m_Storage.resize( getSize() );
+    m_Storage.setSpeciesRegistry( &m_parameters->getSpeciesRegistry() );
+    m_vSiteHandles.assign( getSize(), Site() );
+    m_Neighbours.resize( getSize() );
+    m_vSites.resize( getSize() );
+
+    //The rows are in the y-direction and the columns in the x-direction
+    vector<int> vOrder = mf_order( m_Ordering, m_iSizeY, m_iSizeX );
+    for ( int i = 0; i < getSize(); i++ ){
+        m_vSites[ i ] = &m_vSiteHandles[ vOrder[ i ] ];
+        m_vSites[ i ]->setID( vOrder[ i ] );
+        m_vSites[ i ]->setStorage( &m_Storage );
+        m_vSites[ i ]->setNeighbourTable( &m_Neighbours );
+    }
+    m_Storage.setSites( m_vSiteHandles.data() );
+    m_Neighbours.setSites( m_vSiteHandles.data() );
+}
+
+vector<int> Lattice::mf_order( Ordering ordering, int rows, int columns )
+{
+    vector<int> vOrder( rows*columns );
+    for ( int i = 0; i < rows*columns; i++ )
+        vOrder[ i ] = i;
+
+    if ( ordering == ROW_MAJOR )
+        return vOrder;
+
+    //The Morton key of a site interleaves the bits of its row and its column. The positions are ranked by their key
+    //(the keys of a lattice that is not a power of two in size have gaps which the ranks close).
+    vector<uint64_t> vKeys( rows*columns );
+    for ( int i = 0; i < rows; i++ ){
+        for ( int j = 0; j < columns; j++ ){
+            uint64_t iKey = 0;
+            for ( int b = 0; b < 32; b++ )
+                iKey |= ( (uint64_t)( ( j >> b ) & 1 ) << 2*b ) | ( (uint64_t)( ( i >> b ) & 1 ) << ( 2*b + 1 ) );
+
+            vKeys[ i*columns + j ] = iKey;
+        }
+    }
+
+    vector<int> vPositions = vOrder;
+    sort( vPositions.begin(), vPositions.end(), [&vKeys]( int a, int b ){ return vKeys[ a ] < vKeys[ b ]; } );
+    for ( int i = 0; i < rows*columns; i++ )
+        vOrder[ vPositions[ i ] ] = i;
+
+    return vOrder;
+}
+
+double Lattice::getMemoryPerSite()
+{
+    if ( m_vSites.empty() )
+        return 0.0;
+
+    long iMemory = m_Neighbours.getMemory();
+    for ( Site* s:m_vSites )
+        iMemory += s->getMemory();
+
+    return SiteStorage::getBytesPerSite() + (double)iMemory/m_vSites.size();
+}
+
+const vector<Site *>& Lattice::getSites()
 {
     return m_vSites;
 }
 
 string Lattice::getTypeAsString(){ return  m_sType; }
 
+NeighbourCounter Lattice::getNeighbourCounter(){ return &countNeighbours; }
+
+void Lattice::computeCoordination()
+{
+    m_fCountNeighs = getNeighbourCounter();
+    for ( Site* s:m_vSites )
+        s->setNeighsNum( countCoordination( s ) );
+}
+
+void Lattice::computeSurfaceSums()
+{
+    m_iSumHeights = 0;
+    m_iSumSquaredHeights = 0;
+    m_iSumHeightDiffs = 0;
+    m_bSymmetricNeighs = true;
+
+    for ( Site* s:m_vSites ){
+        long long iHeight = s->getHeight();
+        m_iSumHeights += iHeight;
+        m_iSumSquaredHeights += iHeight*iHeight;
+
+        for ( Site* neigh:s->getNeighs() ){
+            m_iSumHeightDiffs += abs( neigh->getHeight() - s->getHeight() );
+
+            int iCount = 0;
+            for ( Site* other:s->getNeighs() )
+                iCount += ( other == neigh );
+            for ( Site* other:neigh->getNeighs() )
+                iCount -= ( other == s );
+
+            if ( iCount != 0 )
+                m_bSymmetricNeighs = false;
+        }
+    }
+}
+
+int Lattice::countCoordination( Site* s )
+{
+    if ( !m_hasSteps )
+        return m_fCountNeighs( s );
+
+    int iCount = 0;
+    for ( Site* neigh:s->getNeighs() )
+        iCount += mf_counts( s, neigh, neigh->getHeight() );
+
+    return iCount;
+}
+
+bool Lattice::mf_counts( Site* s, Site* neigh, int height )
+{
+    if ( m_hasSteps ){
+        if ( s->isLowerStep() && neigh->isHigherStep() )
+            return height >= s->getHeight() + m_iStepDiff + 1;
+        else if ( neigh->isLowerStep() && s->isHigherStep() )
+            return height >= s->getHeight() - m_iStepDiff + 1;
+    }
+
+    return height >= s->getHeight();
+}
+
+void Lattice::changeHeight( Site* s, int dh )
+{
+    int iOld = s->getHeight();
+    int iNew = iOld + dh;
+    s->setHeight( iNew );
+
+    for ( Site* neigh:s->getNeighs() )
+        neigh->setNeighsNum( neigh->getNeighsNum() + mf_counts( neigh, s, iNew ) - mf_counts( neigh, s, iOld ) );
+
+    s->setNeighsNum( countCoordination( s ) );
+
+    //The sums are shared by the domains of a parallel run
+    long long iDiffs = 0;
+    for ( Site* neigh:s->getNeighs() )
+        iDiffs += abs( neigh->getHeight() - iNew ) - abs( neigh->getHeight() - iOld );
+
+    #pragma omp atomic
+    m_iSumHeights += dh;
+    #pragma omp atomic
+    m_iSumSquaredHeights += (long long)iNew*iNew - (long long)iOld*iOld;
+    //Each difference is in the list of the site and in the list of the neighbour
+    #pragma omp atomic
+    m_iSumHeightDiffs += 2*iDiffs;
+}
+
+void Lattice::computeSpeciesCounts()
+{
+    m_viSpeciesCount.assign( m_parameters->getSpeciesRegistry().size(), 0 );
+    for ( int i = 0; i < getSize(); i++ )
+        m_viSpeciesCount[ m_Storage.getSpecies( i ) ]++;
+}
+
+void Lattice::changeSpecies( Site* s, int species )
+{
+    //The counts are shared by the domains of a parallel run (the species are registered before it starts)
+    #pragma omp atomic
+    m_viSpeciesCount[ s->getSpecies() ]--;
+    #pragma omp atomic
+    m_viSpeciesCount[ species ]++;
+
+    s->setSpecies( species );
+}
+
+vector<double> Lattice::computeCoverages( const vector<int>& species )
+{
+    m_vCoverages.resize( species.size() );
+    for ( unsigned int i = 0; i < species.size(); i++ )
+        m_vCoverages[ i ] = getCoverage( species[ i ] );
+
+    return m_vCoverages;
+}
+
 Lattice::Type Lattice::getType()
 {
     switch (m_Type)
@@ -60,6 +282,8 @@ Lattice::Type Lattice::getType()
         return FCC;
     case SimpleCubic:
         return SimpleCubic;
+    case CoarseGrained:
+        return CoarseGrained;
     default:
         return NONE;
     }
@@ -68,7 +292,13 @@ Lattice::Type Lattice::getType()
 void Lattice::buildSteps(){;}
 
 
-Site* Lattice::getSite(int id) { return m_vSites[id]; }
+Site* Lattice::getSite(int id) { return &m_vSiteHandles[id]; }
+
+int Lattice::getNumBonds(){ return m_Neighbours.getNumBonds(); }
+
+Site* Lattice::getBondSite( int bond ){ return &m_vSiteHandles[ m_Neighbours.getBondSite( bond ) ]; }
+
+Site* Lattice::getBondNeighbour( int bond ){ return &m_vSiteHandles[ m_Neighbours.getBondNeighbour( bond ) ]; }
 
 Site* Lattice::getSite(int i, int j)
 {
@@ -94,20 +324,30 @@ void Lattice::printNeighNum()
     }
 }
 
+void Lattice::printClasses()
+{
+    for (int i = 0; i < m_iSizeY; i++){
+        for (int j = 0; j < m_iSizeX; j++)
+            cout << m_vSites[ i*m_iSizeX + j ]->getID() << "( " << hex << m_vSites[ i*m_iSizeX + j ]->getClassMask() << dec << " )" ;
+
+        cout  << endl;
+    }
+}
+
 void Lattice::printNeighs( int ID )
 {
     cout << "======= Printing neigbors ============ " << endl;
 
     if ( ID < getSize() ){
         cout << "Level 0 neighs: ";
-        for ( int i = 0; i< m_vSites[ ID ]->get1stNeihbors()[ 0 ].size(); i++ )
-            cout << m_vSites[ ID ]->get1stNeihbors()[ 0 ].at( i )->getID() << " ";
+        for ( int i = 0; i< getSite( ID )->get1stNeihbors( 0 ).size(); i++ )
+            cout << getSite( ID )->get1stNeihbors( 0 ).at( i )->getID() << " ";
 
         cout << endl;
 
         cout << "Level -1 neighs: ";
-        for ( int i = 0; i< m_vSites[ ID ]->get1stNeihbors()[ -1 ].size(); i++ )
-            cout << m_vSites[ ID ]->get1stNeihbors()[ -1 ].at( i )->getID() << " ";
+        for ( int i = 0; i< getSite( ID )->get1stNeihbors( -1 ).size(); i++ )
+            cout << getSite( ID )->get1stNeihbors( -1 ).at( i )->getID() << " ";
 
         cout << endl;
 
@@ -133,6 +373,12 @@ void Lattice::printInfo() {
     cout << "Size X: "; cout << getX() << endl;
     cout << "Size Y: "; cout << getY() << endl;
     cout << "Lattice species: "; cout << getLabels() << endl;
+    cout << "Memory per site: "; cout << getMemoryPerSite() << " bytes" << endl;
+    cout << "Site ordering: "; cout << ( m_Ordering == MORTON ? "morton" : "row-major" ) << endl;
+
+    if ( getSitesPerCell() > 1 ) {
+        cout << "Sites per cell: "; cout << getSitesPerCell() << endl;
+    }
 
     if ( hasSteps() ) {
         cout << "Number of steps: "; cout << getNumSteps() << endl;
@@ -25,6 +25,8 @@
 #include <fstream>
 #include "pointers.h"
 #include "site.h"
+#include "site_storage.h"
+#include "neighbour_table.h"
 #include "errorhandler.h"
 #include <set>
 
@@ -39,7 +41,16 @@ class Lattice: public Pointers
        enum Type{
                NONE,
                SimpleCubic,
-               FCC
+               FCC,
+               CoarseGrained
+               };
+
+    /// The order of the sites in the storage. In row-major order the ID of a site is its position in the lattice (i*X + j).
+    /// In Morton (Z-order) order the sites that are close in the lattice are close in the storage as well
+    /// (the neighbours in the next row are not a full row away). The sites keep their position in the lattice in either order.
+       enum Ordering{
+               ROW_MAJOR,
+               MORTON
                };
 
     /// Constructor
@@ -66,6 +77,9 @@ class Lattice: public Pointers
     /// Returns the size of the lattice.
     inline int getSize(){ return m_iSizeX*m_iSizeY; }
 
+    /// Returns the number of sites of the surface in every site of the lattice (more than one if the sites are coarse-grained cells).
+    virtual int getSitesPerCell(){ return 1; }
+
     virtual int getNumFirstNeihgs(){;}
 
     /// Builds a  stepped surface
@@ -83,8 +97,23 @@ class Lattice: public Pointers
     /// Returns a site with a specific id as in 2D space.
     Site* getSite( int i, int j);
 
-    /// Returns all the sites of the lattice.
-    vector<Site*> getSites();
+    /// Returns the number of bonds of the lattice i.e. of the neighbours of all its sites (see NeighbourTable).
+    int getNumBonds();
+
+    /// Returns the site that the bond starts from.
+    Site* getBondSite( int bond );
+
+    /// Returns the neighbour that the bond ends to.
+    Site* getBondNeighbour( int bond );
+
+    /// Returns all the sites of the lattice in their position in the lattice (row-major).
+    const vector<Site*>& getSites();
+
+    /// Sets the order of the sites in the storage. It must be set before the lattice is built.
+    inline void setOrdering( Ordering ordering ){ m_Ordering = ordering; }
+
+    /// Returns the order of the sites in the storage.
+    inline Ordering getOrdering(){ return m_Ordering; }
 
     /// Init the lattice.
     void init();
@@ -101,6 +130,10 @@ class Lattice: public Pointers
     /// Build the lattice with an intitial height.
     virtual void build() = 0;
 
+    /// Builds the lattice as a copy of a lattice already built from the same input (no neighbours are searched).
+    /// The sites are copied and everything they point to is mapped to the sites of this lattice.
+    virtual void copyFrom( Lattice* lattice );
+
     /// Sets the minimun initial height for the lattice.
     void setInitialHeight( int  height );
 
@@ -120,6 +153,9 @@ class Lattice: public Pointers
     void print();
     void printNeighNum();
 
+    /// Prints the classes of the processes that each site belongs to (as a mask in hexadecimal, bit i for the process with ID i).
+    void printClasses();
+
     //Prints the neighbors
     void printNeighs(int);
 
@@ -146,11 +182,60 @@ class Lattice: public Pointers
     /// Prints general info for this lattice
     void printInfo();
 
+    /// Returns the average memory of a site i.e. its state in the storage, its handle and its neighbours in the table [bytes].
+    double getMemoryPerSite();
+
     /// Returns the lattice type as string
     string getTypeAsString();
 
-    /// Returns the coverages of each species adsorbed
-    virtual unordered_map<string, double > computeCoverages( vector<string> species ){}
+    /// Returns the kernel counting the neighbours of a site that are at least as high as it.
+    /// The lattices with a stencil return the kernel instantiated for it.
+    virtual NeighbourCounter getNeighbourCounter();
+
+    /// Counts the coordination number of every site from its neighbours i.e. the number of its neighbours that are at least
+    /// as high as it (on a stepped surface the heights across the step are compared with the step difference).
+    /// It is called after the lattice is built; then the coordination numbers are kept by changeHeight.
+    void computeCoordination();
+
+    /// Returns the coordination number of the site counted from its neighbours.
+    int countCoordination( Site* s );
+
+    /// Changes the height of the site and updates the coordination numbers: the site is counted again
+    /// and each of its neighbours changes by the change of whether it counts the site (i.e. by at most one).
+    void changeHeight( Site* s, int dh );
+
+    /// Sums the heights, the squared heights and the height differences of the neighbours over the lattice.
+    /// It is called after the lattice is built or restored; then the sums are kept by changeHeight.
+    void computeSurfaceSums();
+
+    /// Returns the sum of the heights of the sites.
+    inline long long getSumHeights(){ return m_iSumHeights; }
+
+    /// Returns the sum of the squared heights of the sites.
+    inline long long getSumSquaredHeights(){ return m_iSumSquaredHeights; }
+
+    /// Returns the sum of |h(s) - h(n)| over every site s and every neighbour n in its list.
+    inline long long getSumHeightDifferences(){ return m_iSumHeightDiffs; }
+
+    /// Returns true if every site is in the neighbours of its neighbours (as many times as they are in its own)
+    /// i.e. if the sum of the height differences can be kept by changeHeight.
+    inline bool hasSymmetricNeighbours(){ return m_bSymmetricNeighs; }
+
+    /// Counts the sites of every registered species. It is called after the processes have registered their species
+    /// and after the lattice is restored; then the counts are kept by changeSpecies.
+    virtual void computeSpeciesCounts();
+
+    /// Changes the species of the site and updates the counts of the species.
+    void changeSpecies( Site* s, int species );
+
+    /// Returns the number of sites with the given species (by its ID).
+    inline int getSpeciesCount( int species ){ return species < (int)m_viSpeciesCount.size() ? m_viSpeciesCount[ species ] : 0; }
+
+    /// Returns the coverage of the given species (by its ID) i.e. the fraction of the sites with it.
+    inline double getCoverage( int species ){ return (double)getSpeciesCount( species )/( (double)getSize()*getSitesPerCell() ); }
+
+    /// Returns the coverage of each of the given species (by their ID) in the order they are given
+    vector<double> computeCoverages( const vector<int>& species );
 
 protected:
     /// The size of the lattice in the x-dimension.
@@ -168,9 +253,45 @@ protected:
     /// The type of the lattice in string: BCC, FCC etc.
     string m_sType;
 
-    /// The sites that consist the lattice.
+    /// Allocates the sites of the lattice (getSize() of them) with their IDs set to their position in the storage.
+    /// The sites are stored contiguously (in the order of the lattice) and their state in the storage of the lattice.
+    void mf_allocateSites();
+
+    /// Returns the position in the storage of every position in the lattice for the given order.
+    static vector<int> mf_order( Ordering ordering, int rows, int columns );
+
+    /// Returns true if the site counts its neighbour in its coordination number when the neighbour has the given height.
+    bool mf_counts( Site* s, Site* neigh, int height );
+
+    /// The kernel counting the coordination number of a site on a surface without steps
+    NeighbourCounter m_fCountNeighs;
+
+    /// The running sums of the heights, the squared heights and the height differences of the neighbours
+    long long m_iSumHeights;
+    long long m_iSumSquaredHeights;
+    long long m_iSumHeightDiffs;
+
+    /// True if the neighbours of the sites are symmetric
+    bool m_bSymmetricNeighs;
+
+    /// The number of sites with each species (by its ID)
+    vector<int> m_viSpeciesCount;
+
+    /// The sites that consist the lattice in their position in the lattice (they point in m_vSiteHandles).
     vector<Site* > m_vSites;
 
+    /// The sites of the lattice stored contiguously. The ID of each site is its position here.
+    vector<Site> m_vSiteHandles;
+
+    /// The order of the sites in the storage
+    Ordering m_Ordering;
+
+    /// The state of the sites.
+    SiteStorage m_Storage;
+
+    /// The neighbours of the sites. The lattices add them while they are built and compress the table when they are done.
+    NeighbourTable m_Neighbours;
+
     /// True if the lattice has steps (comes from the input file if the Step keyword is found).
     bool m_hasSteps = false;
 
@@ -192,7 +313,7 @@ protected:
     string m_sLabel;
 
     /// The coveraages at each time
-    unordered_map<string, double> m_mCoverages;
+    vector<double> m_vCoverages;
   };
 
 #endif // LATTICE_H
@@ -0,0 +1,93 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "neighbour_table.h"
+//The members of NeighbourSpan that read the sites are defined where the sites are complete
+#include "site.h"
+
+#include <algorithm>
+
+namespace SurfaceTiles
+{
+
+NeighbourTable::NeighbourTable():m_pSites( 0 ), m_bCompressed( false ){}
+
+NeighbourTable::~NeighbourTable(){}
+
+void NeighbourTable::resize( int size )
+{
+    m_bCompressed = false;
+
+    for ( int l = 0; l < LISTS; l++ ){
+        m_vOffsets[ l ].clear();
+        m_vNeighs[ l ].clear();
+        m_vBuild[ l ].assign( size, vector<int32_t>() );
+    }
+}
+
+void NeighbourTable::add( int id, List list, int neigh )
+{
+    m_vBuild[ list ][ id ].push_back( neigh );
+}
+
+void NeighbourTable::compress()
+{
+    for ( int l = 0; l < LISTS; l++ ){
+        vector< vector<int32_t> >& vBuild = m_vBuild[ l ];
+
+        int iTotal = 0;
+        for ( const vector<int32_t>& v:vBuild )
+            iTotal += v.size();
+
+        m_vOffsets[ l ].assign( 1, 0 );
+        m_vOffsets[ l ].reserve( vBuild.size() + 1 );
+        m_vNeighs[ l ].clear();
+        m_vNeighs[ l ].reserve( iTotal );
+
+        for ( const vector<int32_t>& v:vBuild ){
+            m_vNeighs[ l ].insert( m_vNeighs[ l ].end(), v.begin(), v.end() );
+            m_vOffsets[ l ].push_back( m_vNeighs[ l ].size() );
+        }
+
+        //The per site lists are released
+        vector< vector<int32_t> >().swap( vBuild );
+    }
+
+    m_bCompressed = true;
+}
+
+int NeighbourTable::getBondSite( int bond ) const
+{
+    //The last site whose first bond is not after the bond
+    const vector<int32_t>& vOffsets = m_vOffsets[ NEIGHS ];
+    return upper_bound( vOffsets.begin(), vOffsets.end(), bond ) - vOffsets.begin() - 1;
+}
+
+long NeighbourTable::getMemory() const
+{
+    long iMemory = sizeof( NeighbourTable );
+    for ( int l = 0; l < LISTS; l++ ){
+        iMemory += m_vOffsets[ l ].capacity()*sizeof( int32_t ) + m_vNeighs[ l ].capacity()*sizeof( int32_t );
+        iMemory += m_vBuild[ l ].capacity()*sizeof( vector<int32_t> );
+        for ( const vector<int32_t>& v:m_vBuild[ l ] )
+            iMemory += v.capacity()*sizeof( int32_t );
+    }
+
+    return iMemory;
+}
+
+}
@@ -0,0 +1,166 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef NEIGHBOUR_TABLE_H
+#define NEIGHBOUR_TABLE_H
+
+#include <vector>
+#include <cstdint>
+#include <iterator>
+
+using namespace std;
+
+namespace SurfaceTiles
+{
+
+class Site;
+
+/// A kernel that counts the neighbours of a site that are at least as high as it (see stencil.h).
+typedef int (*NeighbourCounter)( Site* );
+
+/** A range of neighbours in a NeighbourTable. Like a span it only points in the table, so getting it never
+ * allocates or copies and it is valid while the table is not changed. It is iterated as a range of sites. */
+class NeighbourSpan
+{
+public:
+    class iterator
+    {
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef Site* value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Site* const* pointer;
+        typedef Site* reference;
+
+        iterator( const int32_t* index, Site* sites ):m_pIndex( index ), m_pSites( sites ){}
+
+        inline Site* operator*() const;
+        inline iterator& operator++(){ ++m_pIndex; return *this; }
+        inline iterator operator++( int ){ iterator it = *this; ++m_pIndex; return it; }
+        inline bool operator==( const iterator& it ) const { return m_pIndex == it.m_pIndex; }
+        inline bool operator!=( const iterator& it ) const { return m_pIndex != it.m_pIndex; }
+
+    private:
+        const int32_t* m_pIndex;
+        Site* m_pSites;
+    };
+
+    NeighbourSpan( const int32_t* begin, const int32_t* end, Site* sites ):m_pBegin( begin ), m_pEnd( end ), m_pSites( sites ){}
+
+    inline iterator begin() const { return iterator( m_pBegin, m_pSites ); }
+    inline iterator end() const { return iterator( m_pEnd, m_pSites ); }
+
+    /// Returns the number of neighbours.
+    inline int size() const { return m_pEnd - m_pBegin; }
+    inline bool empty() const { return m_pEnd == m_pBegin; }
+
+    /// Returns the i-th neighbour (defined in site.h where the sites are complete).
+    inline Site* operator[]( int i ) const;
+    inline Site* at( int i ) const { return operator[]( i ); }
+
+    /// Returns the ID of the i-th neighbour.
+    inline int getID( int i ) const { return m_pBegin[ i ]; }
+
+private:
+    const int32_t* m_pBegin;
+    const int32_t* m_pEnd;
+    Site* m_pSites;
+};
+
+/** The neighbours of the sites of a lattice in compressed sparse row form: for every list of neighbours
+ * (the neighbours of the site and its 1st neighbours below, at the same level and above) the IDs of the neighbours of all the sites
+ * are stored in one flat array and the neighbours of site i are between the offsets i and i+1.
+ * The lattice adds the neighbours while it is built and then compresses the table. Until it is compressed
+ * the neighbours are kept per site (and can be read as well).
+ * Once compressed, the position of a neighbour in the flat array of NEIGHS is the ID of the bond from the site
+ * to that neighbour, so the bonds of the lattice are numbered densely [0, getNumBonds()). */
+class NeighbourTable
+{
+public:
+    /// The lists of neighbours of every site.
+    enum List{
+        NEIGHS,
+        BELOW,
+        SAME,
+        ABOVE,
+        LISTS
+    };
+
+    NeighbourTable();
+    virtual ~NeighbourTable();
+
+    /// Empties the table and prepares it for the neighbours of the given number of sites.
+    void resize( int size );
+
+    /// The sites that the IDs refer to (the site with ID i is at position i). They are not owned.
+    inline void setSites( Site* sites ){ m_pSites = sites; }
+
+    /// Adds a neighbour at the end of a list of the site. The table must not be compressed.
+    void add( int id, List list, int neigh );
+
+    /// Stores the neighbours of all the sites contiguously. No more neighbours can be added after this.
+    void compress();
+
+    /// Returns true if the table is compressed.
+    inline bool isCompressed() const { return m_bCompressed; }
+
+    /// Returns a list of neighbours of the site.
+    inline NeighbourSpan get( int id, List list ) const {
+        if ( m_bCompressed ){
+            const int32_t* pBegin = m_vNeighs[ list ].data();
+            return NeighbourSpan( pBegin + m_vOffsets[ list ][ id ], pBegin + m_vOffsets[ list ][ id + 1 ], m_pSites );
+        }
+
+        const vector<int32_t>& vNeighs = m_vBuild[ list ][ id ];
+        return NeighbourSpan( vNeighs.data(), vNeighs.data() + vNeighs.size(), m_pSites );
+    }
+
+    /// Returns the ID of the bond from the site to its i-th neighbour (NEIGHS). The table must be compressed.
+    inline int getBond( int id, int i ) const { return m_vOffsets[ NEIGHS ][ id ] + i; }
+
+    /// Returns the number of bonds i.e. of the neighbours of all the sites (NEIGHS). The table must be compressed.
+    inline int getNumBonds() const { return m_vNeighs[ NEIGHS ].size(); }
+
+    /// Returns the ID of the site that the bond starts from.
+    int getBondSite( int bond ) const;
+
+    /// Returns the ID of the site that the bond ends to (the neighbour).
+    inline int getBondNeighbour( int bond ) const { return m_vNeighs[ NEIGHS ][ bond ]; }
+
+    /// Returns the memory used by the table [bytes].
+    long getMemory() const;
+
+private:
+    /// The sites (not owned)
+    Site* m_pSites;
+
+    /// True if the neighbours are stored in the flat arrays
+    bool m_bCompressed;
+
+    /// The position of the first neighbour of every site in each list (one more than the sites)
+    vector<int32_t> m_vOffsets[ LISTS ];
+
+    /// The IDs of the neighbours of all the sites in each list
+    vector<int32_t> m_vNeighs[ LISTS ];
+
+    /// The neighbours of every site in each list while the lattice is built
+    vector< vector<int32_t> > m_vBuild[ LISTS ];
+};
+
+}
+
+#endif // NEIGHBOUR_TABLE_H
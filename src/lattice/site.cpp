@@ -23,13 +23,21 @@
 namespace SurfaceTiles
 {
 
-  Site::Site():m_phantom(false),m_isLowerStep(false), m_isHigherStep(false)
+  Site::Site():m_iID(0), m_pStorage(nullptr), m_pNeighbours(nullptr), m_aNeigh{}{}
+
+  Site::~Site() {}
+
+  void Site::remap( const vector<Site*>& sites )
   {
-      vector<Site* > vec;
-      m_m1stNeighs = { {-1, vec}, { 0, vec }, {1, vec }, };
+      for ( Site*& s:m_aNeigh )
+          if ( s )
+              s = sites[ s->getID() ];
   }
 
-  Site::~Site() {}
+  long Site::getMemory() const
+  {
+      return sizeof( Site );
+  }
 
 } // namespace SurfaceTiles
 
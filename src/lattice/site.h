@@ -25,12 +25,16 @@
 #include <valarray>
 
 #include "process.h"
+#include "site_storage.h"
+#include "neighbour_table.h"
 
 using namespace std;
 using namespace MicroProcesses;
 
 /**  The site is where a process will be performed. The lattice is
- * a series of sites put together in space with certain symmetry. */
+ * a series of sites put together in space with certain symmetry.
+ * The site is a handle: its state (height, labels, occupancy etc.) is stored in the arrays of the SiteStorage
+ * of its lattice at the position of its ID and its neighbours in the NeighbourTable of its lattice. */
 
 namespace SurfaceTiles
 {
@@ -77,17 +81,26 @@ public:
         ACTV_SOUTH
     };
 
+    /// Set the storage of the state of the site.
+    inline void setStorage( SiteStorage* storage ){ m_pStorage = storage; }
+
+    /// Set the table of the neighbours of the site.
+    inline void setNeighbourTable( NeighbourTable* neighbours ){ m_pNeighbours = neighbours; }
+
     /// Set the height of the particular site.
-    inline void setHeight( int h ) { m_iHeight = h; }
+    inline void setHeight( int h ) { m_pStorage->setHeight( m_iID, h ); }
 
     /// Get the height of the particular site.
-    inline int getHeight() { return m_iHeight; }
+    inline int getHeight() { return m_pStorage->getHeight( m_iID ); }
 
     /// Set the neigbours.
-    inline void setNeigh(Site *s){ m_vNeigh.push_back(s); }
+    inline void setNeigh(Site *s){ m_pNeighbours->add( m_iID, NeighbourTable::NEIGHS, s->getID() ); }
 
-    /// Get the neigbours at the same level.
-    inline vector<Site *> getNeighs() { return m_vNeigh; }
+    /// Get the neigbours at the same level (they point in the table of the neighbours so nothing is copied).
+    inline NeighbourSpan getNeighs() const { return m_pNeighbours->get( m_iID, NeighbourTable::NEIGHS ); }
+
+    /// Returns the ID of the bond from this site to its i-th neighbour (see NeighbourTable).
+    inline int getBond( int i ) const { return m_pNeighbours->getBond( m_iID, i ); }
 
     /// Set an ID for this site.
     inline void setID(int id) { m_iID = id; }
@@ -96,151 +109,115 @@ public:
     inline int getID() { return m_iID; }
 
     /// Set the number of the neighbours according to the height of its neighbour sites
-    inline void setNeighsNum( int n ) { m_iNumNeighs = n; }
+    inline void setNeighsNum( int n ) { m_pStorage->setNeighsNum( m_iID, n ); }
 
     /// Returns the number of the neighbours according to the height of its neighbour sites.
-    inline int getNeighsNum(){ return m_iNumNeighs; }
+    inline int getNeighsNum(){ return m_pStorage->getNeighsNum( m_iID ); }
 
-    /// Set the neihbour position for this site.
-    inline void setNeighPosition(Site *s, NeighPoisition np) { m_mapNeigh[ np ] = s; }
+    /// Returns the classes of the processes that the site belongs to (bit i for the process with ID i).
+    inline ClassMask getClassMask(){ return m_pStorage->getClassMask( m_iID ); }
 
-    /// Get the neihbour position for this site.
-    Site* getNeighPosition(NeighPoisition np){ return m_mapNeigh[np]; }
+    /// Sets the classes of the processes that the site belongs to.
+    inline void setClassMask( ClassMask mask ){ m_pStorage->setClassMask( m_iID, mask ); }
 
-    vector<string> getSpeciesName();
+    /// Set the neihbour position for this site.
+    inline void setNeighPosition(Site *s, NeighPoisition np) { m_aNeigh[ np ] = s; }
 
-    // Get the react species
-    inline valarray< int > getReactSpecies() { return m_vReacSpecies; }
+    /// Get the neihbour position for this site.
+    Site* getNeighPosition(NeighPoisition np){ return m_aNeigh[np]; }
 
     /// Increase the height of the site by one
-    inline void increaseHeight( int i ){ m_iHeight += i; }
+    inline void increaseHeight( int i ){ m_pStorage->setHeight( m_iID, m_pStorage->getHeight( m_iID ) + i ); }
 
     /// Decrease the height of the site by one
-    inline void decreaseHeight( int i ){ m_iHeight -= i; }
+    inline void decreaseHeight( int i ){ m_pStorage->setHeight( m_iID, m_pStorage->getHeight( m_iID ) - i ); }
 
-    /// Set the first negihbors of this site
-    void set1stNeibors( int level, Site* s) { m_m1stNeighs.at( level ).push_back( s ); }
+    /// Set the first negihbors of this site in the given level (-1 below, 0 same, 1 above)
+    void set1stNeibors( int level, Site* s) { m_pNeighbours->add( m_iID, mf_levelList( level ), s->getID() ); }
 
-    /// Returns the 1st neigbors
-    inline map<int, vector<Site* > > get1stNeihbors() const { return m_m1stNeighs; }
+    /// Returns the 1st neigbors in the given level (-1 below, 0 same, 1 above)
+    inline NeighbourSpan get1stNeihbors( int level ) const { return m_pNeighbours->get( m_iID, mf_levelList( level ) ); }
 
     /// Returns true if is in lower step (used in the step case only)
-    void setLowerStep( bool b){ m_isLowerStep = b; }
+    void setLowerStep( bool b){ m_pStorage->setFlag( m_iID, SiteStorage::LOWER_STEP, b ); }
 
     /// Returns true if is in higher step (used in the step case only)
-    void setHigherStep( bool b) { m_isHigherStep = b; }
+    void setHigherStep( bool b) { m_pStorage->setFlag( m_iID, SiteStorage::HIGHER_STEP, b ); }
 
     /// Returns true if is in lower step (used in the step case only)
-    bool isLowerStep(){ return m_isLowerStep; }
+    bool isLowerStep(){ return m_pStorage->hasFlag( m_iID, SiteStorage::LOWER_STEP ); }
 
     /// Returns true if is in higher step (used in the step case only)
-    bool isHigherStep() { return m_isHigherStep; }
+    bool isHigherStep() { return m_pStorage->hasFlag( m_iID, SiteStorage::HIGHER_STEP ); }
+
+    /// Sets the species of the site (its ID in the species registry)
+    inline void setSpecies( int species ){ m_pStorage->setSpecies( m_iID, species ); }
+
+    /// Returns the species of the site (its ID in the species registry)
+    inline int getSpecies(){ return m_pStorage->getSpecies( m_iID ); }
+
+    /// Sets the species below the site
+    inline void setBelowSpecies( int species ){ m_pStorage->setBelowSpecies( m_iID, species ); }
+
+    /// Returns the species below the site
+    inline int getBelowSpecies(){ return m_pStorage->getBelowSpecies( m_iID ); }
 
     /// Testing: adding species formula
-    inline void setLabel( string formula ){ m_sLabel = formula; }
+    inline void setLabel( const string& formula ){ m_pStorage->setLabel( m_iID, formula ); }
 
     /// Testing: geting species formula
-    inline string getLabel(){ return m_sLabel; }
+    inline const string& getLabel(){ return m_pStorage->getLabel( m_iID ); }
 
     /// Testing: adding species formula
-    inline void setBelowLabel( string formula ){ m_sBelowLabel = formula; }
+    inline void setBelowLabel( const string& formula ){ m_pStorage->setBelowLabel( m_iID, formula ); }
 
     /// Testing: geting species formula
-    inline string getBelowLabel(){ return m_sBelowLabel; }
+    inline const string& getBelowLabel(){ return m_pStorage->getBelowLabel( m_iID ); }
 
     /// This site is coupled with another one (for dimmer formation)
-    inline void setCoupledSite(Site* s){ m_pCoupledSite = s; }
+    inline void setCoupledSite(Site* s){ m_pStorage->setCoupled( m_iID, s ? s->getID() : -1 ); }
 
     /// Get the couple site of this site
-    inline Site* getCoupledSite(){ return  m_pCoupledSite;}
+    inline Site* getCoupledSite(){ int iCoupled = m_pStorage->getCoupled( m_iID ); return iCoupled < 0 ? nullptr : m_pStorage->getSites() + iCoupled; }
 
     /// Remove the coupled site
-    inline void removeCouple(){ m_pCoupledSite = nullptr; }
+    inline void removeCouple(){ m_pStorage->setCoupled( m_iID, -1 ); }
 
     /// Sets if this site is occupied by a species or not
-    inline void setOccupied( bool occupied ){ m_bIsOccupied = occupied; }
+    inline void setOccupied( bool occupied ){ m_pStorage->setFlag( m_iID, SiteStorage::OCCUPIED, occupied ); }
 
     /// Checks if this site is occupied by a species or not
-    inline bool isOccupied(){ return m_bIsOccupied; }
+    inline bool isOccupied(){ return m_pStorage->hasFlag( m_iID, SiteStorage::OCCUPIED ); }
 
-protected:
-    //The lattice type that this site belongs to
-    //LatticeType m_LatticeType;
+    /// Maps every site that this site points to (i.e. its neighbours by orientation) to the site with the same ID in the given sites.
+    /// Used when the sites of a lattice are copied to another lattice.
+    void remap( const vector<Site*>& sites );
 
+    /// Returns the memory used by the site (its state and its neighbours are in the tables of the lattice).
+    long getMemory() const;
+
+protected:
     /// The ID of the site.
     int m_iID;
 
-    /// The height in the particular position.
-    int m_iHeight;
-
-    /// The neighbours at the same level.
-    vector< Site*> m_vNeigh;
+    /// The storage of the state of the site.
+    SiteStorage* m_pStorage;
 
-    /// Holds the number of the neighbours of the particular site according to each height/
-    int m_iNumNeighs;
+    /// The table of the neighbours.
+    NeighbourTable* m_pNeighbours;
 
-    /// A map that holds the neighbour sites according to their orientation.
-    map< NeighPoisition, Site*> m_mapNeigh;
-
-    /// A map that hold the sites that this site can activate if it has all the its neighbours occupied.
-    map< ActivationSite, Site* > m_mapAct;
-
-    /// A list of active sites for each process
-    map< Process*, vector<Site*>> activeSites;
-
-    /// A map counting the species that are present
-    map<int, int> m_mapSpecies;
-
-    /// To check if a site is occupied or not.
-    bool m_bIsOccupied;
-
-    /// The list of processes that this site can participate in.
-    list< Process* > m_lProcs;
-
-    bool m_phantom;
-
-    //Holds the number of the reactants species in this site.
-    // m_vReacSpecies has size the number of ALL reactants species
-    valarray< int > m_vReacSpecies;
-
-    /// The number of first neighs
-    int m_iFirstNeighs;
-
-    /// The number of second neighs
-    int m_iSecondNeighs;
-
-    /// The label of this site
-    string m_sLabel;
-
-    /// The label of the site below this site (in case of multiple species growth)
-    string m_sBelowLabel;
-
-    /// Coupled site
-    Site* m_pCoupledSite;
+    /// The neighbour sites according to their orientation (null if there is no neighbour in that orientation).
+    Site* m_aNeigh[ SOUTH + 1 ];
 
 private:
-    /// Orientation of the lattice
-    string m_sOrint;
-
-    /// The 1st neighbors in the different levels
-    /// below level
-    /// same level
-    /// upper level
-    map< int, vector <Site* > > m_m1stNeighs;
-
-    /// The 2nd nearest neighbors in the different levels
-    /// below level
-    /// same level
-    /// upper level
-    map< int, vector <Site* > > m_m2ndNeighs;
-
-    /// if the site belong to the lower step storing vaious info
-    bool m_isLowerStep;
-
-    /// if the site belong to the higher step storing vaious info
-    bool m_isHigherStep;
+    /// Returns the list of the 1st neighbours in the given level
+    static inline NeighbourTable::List mf_levelList( int level ){ return level < 0 ? NeighbourTable::BELOW : ( level == 0 ? NeighbourTable::SAME : NeighbourTable::ABOVE ); }
 };
 
+inline Site* NeighbourSpan::iterator::operator*() const { return m_pSites + *m_pIndex; }
+
+inline Site* NeighbourSpan::operator[]( int i ) const { return m_pSites + m_pBegin[ i ]; }
+
 }
 
 #endif
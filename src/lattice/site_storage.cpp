@@ -0,0 +1,59 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "site_storage.h"
+
+namespace SurfaceTiles
+{
+
+SiteStorage::SiteStorage():m_pSites( 0 ), m_pSpecies( 0 ){}
+
+SiteStorage::SiteStorage( const SiteStorage& storage ):m_pSites( 0 ), m_pSpecies( 0 ){ *this = storage; }
+
+SiteStorage& SiteStorage::operator=( const SiteStorage& storage )
+{
+    m_vHeight = storage.m_vHeight;
+    m_vNeighsNum = storage.m_vNeighsNum;
+    m_vFlags = storage.m_vFlags;
+    m_vSpecies = storage.m_vSpecies;
+    m_vBelowSpecies = storage.m_vBelowSpecies;
+    m_vCoupled = storage.m_vCoupled;
+    m_vClassMask = storage.m_vClassMask;
+
+    return *this;
+}
+
+SiteStorage::~SiteStorage(){}
+
+void SiteStorage::resize( int size )
+{
+    m_vHeight.assign( size, 0 );
+    m_vNeighsNum.assign( size, 0 );
+    m_vFlags.assign( size, 0 );
+    m_vSpecies.assign( size, 0 );
+    m_vBelowSpecies.assign( size, 0 );
+    m_vCoupled.assign( size, -1 );
+    m_vClassMask.assign( size, 0 );
+}
+
+int SiteStorage::getBytesPerSite()
+{
+    //Height, neighbours, flags, species, species below, coupled site and classes
+    return sizeof( int ) + sizeof( int ) + sizeof( uint8_t ) + sizeof( int ) + sizeof( int ) + sizeof( int ) + sizeof( ClassMask );
+}
+
+}
@@ -0,0 +1,133 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef SITE_STORAGE_H
+#define SITE_STORAGE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "species_registry.h"
+
+using namespace std;
+
+namespace SurfaceTiles
+{
+
+class Site;
+
+/// The classes of the processes that a site belongs to: bit i is set if the site is in the class of the process with ID i.
+typedef uint64_t ClassMask;
+
+/** The state of the sites of a lattice stored as a structure of arrays i.e. one contiguous array
+ * for each quantity (height, coordination, occupancy and step flags, species, coupled site, classes) indexed by the site ID.
+ * The sites are handles to their entries in these arrays so the state of the whole lattice is a few bytes per site
+ * and a sweep over the lattice (e.g. the coverages or the heights) reads memory sequentially.
+ * The species are stored as their IDs in the species registry of the instance (the labels are their names). */
+class SiteStorage
+{
+public:
+    /// The flags stored for each site.
+    enum Flag{
+        OCCUPIED = 1,
+        LOWER_STEP = 2,
+        HIGHER_STEP = 4
+    };
+
+    SiteStorage();
+    SiteStorage( const SiteStorage& storage );
+    SiteStorage& operator=( const SiteStorage& storage );
+    virtual ~SiteStorage();
+
+    /// Allocates the storage for the given number of sites. Every site has zero height, no flags, the empty species and no coupled site.
+    void resize( int size );
+
+    /// The sites that the storage belongs to (their position in the array is their ID). They are not owned.
+    inline void setSites( Site* sites ){ m_pSites = sites; }
+
+    /// Returns the sites (the site with ID i is at position i).
+    inline Site* getSites(){ return m_pSites; }
+
+    /// The registry of the species that the sites refer to. It is not owned and it is not copied with the storage.
+    inline void setSpeciesRegistry( SpeciesRegistry* species ){ m_pSpecies = species; }
+
+    inline int getHeight( int id ) const { return m_vHeight[ id ]; }
+    inline void setHeight( int id, int height ){ m_vHeight[ id ] = height; }
+
+    inline int getNeighsNum( int id ) const { return m_vNeighsNum[ id ]; }
+    inline void setNeighsNum( int id, int neighs ){ m_vNeighsNum[ id ] = neighs; }
+
+    inline bool hasFlag( int id, Flag flag ) const { return m_vFlags[ id ] & flag; }
+    inline void setFlag( int id, Flag flag, bool set ){ m_vFlags[ id ] = set ? ( m_vFlags[ id ] | flag ) : ( m_vFlags[ id ] & ~flag ); }
+
+    inline int getSpecies( int id ) const { return m_vSpecies[ id ]; }
+    inline void setSpecies( int id, int species ){ m_vSpecies[ id ] = species; }
+
+    inline int getBelowSpecies( int id ) const { return m_vBelowSpecies[ id ]; }
+    inline void setBelowSpecies( int id, int species ){ m_vBelowSpecies[ id ] = species; }
+
+    /// The names of the species (for reading and writing). A new label is registered so it must not be set during a parallel run.
+    inline const string& getLabel( int id ) const { return m_pSpecies->getName( m_vSpecies[ id ] ); }
+    inline void setLabel( int id, const string& label ){ m_vSpecies[ id ] = m_pSpecies->add( label ); }
+
+    inline const string& getBelowLabel( int id ) const { return m_pSpecies->getName( m_vBelowSpecies[ id ] ); }
+    inline void setBelowLabel( int id, const string& label ){ m_vBelowSpecies[ id ] = m_pSpecies->add( label ); }
+
+    /// Returns the ID of the site coupled with the site (-1 if it is not coupled).
+    inline int getCoupled( int id ) const { return m_vCoupled[ id ]; }
+    inline void setCoupled( int id, int coupled ){ m_vCoupled[ id ] = coupled; }
+
+    /// The classes of the processes that the site belongs to (kept by the engine).
+    inline ClassMask getClassMask( int id ) const { return m_vClassMask[ id ]; }
+    inline void setClassMask( int id, ClassMask mask ){ m_vClassMask[ id ] = mask; }
+
+    /// Returns the bytes stored for each site.
+    static int getBytesPerSite();
+
+private:
+    /// The sites (not owned)
+    Site* m_pSites;
+
+    /// The height of each site
+    vector<int> m_vHeight;
+
+    /// The number of neighbours of each site according to the heights
+    vector<int> m_vNeighsNum;
+
+    /// The flags of each site
+    vector<uint8_t> m_vFlags;
+
+    /// The species of each site
+    vector<int> m_vSpecies;
+
+    /// The species below each site
+    vector<int> m_vBelowSpecies;
+
+    /// The ID of the site coupled with each site (-1 if none)
+    vector<int> m_vCoupled;
+
+    /// The classes of each site
+    vector<ClassMask> m_vClassMask;
+
+    /// The registry of the species (not owned)
+    SpeciesRegistry* m_pSpecies;
+};
+
+}
+
+#endif // SITE_STORAGE_H
@@ -0,0 +1,203 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef STENCIL_H
+#define STENCIL_H
+
+#include <vector>
+
+#include "site.h"
+#include "neighbour_table.h"
+
+using namespace std;
+
+/** The stencils of the lattices: the neighbours of a site described at compile time as offsets in rows and columns
+ * from it (with periodic boundary conditions). The lattices build their neighbour tables from them and
+ * the neighbour counting kernels are instantiated for each of them, so their loops have a fixed number of neighbours. */
+
+namespace SurfaceTiles
+{
+
+/// A neighbour in a stencil: its offset in rows and columns, the list of the neighbour table where it is added
+/// (LISTS if it is not added in any list) and its position (NONE if it has no position).
+struct StencilOffset
+{
+    enum { NONE = -1 };
+
+    int iRow;
+    int iColumn;
+    NeighbourTable::List list;
+    int iPosition;
+};
+
+/// Returns the index i in [0, size) i.e. wrapped around the periodic boundaries (|i| < size).
+constexpr int wrap( int i, int size ){ return i < 0 ? i + size : ( i >= size ? i - size : i ); }
+
+/// Returns the number of the offsets of a stencil that are added in the given list.
+/// Every variant of the stencil must have the same number of them.
+template< class Stencil >
+constexpr int stencilSize( NeighbourTable::List list )
+{
+    int iSize = 0;
+    for ( const StencilOffset& offset:Stencil::aOffsets[ 0 ] )
+        if ( offset.list == list )
+            iSize++;
+
+    return iSize;
+}
+
+/// The simple cubic lattice: the four neighbours at the same level.
+struct SimpleCubicStencil
+{
+    static constexpr int iVariants = 1;
+    static constexpr int iOffsets = 4;
+    static constexpr StencilOffset aOffsets[ iVariants ][ iOffsets ] = {
+        {
+            { -1,  0, NeighbourTable::NEIGHS, Site::NORTH },
+            {  1,  0, NeighbourTable::NEIGHS, Site::SOUTH },
+            {  0,  1, NeighbourTable::NEIGHS, Site::EAST },
+            {  0, -1, NeighbourTable::NEIGHS, Site::WEST }
+        }
+    };
+
+    static constexpr int variant( int, int ){ return 0; }
+};
+
+/// The FCC(110) lattice: the four neighbours at the same level (two columns apart in the row) and the four 1st neighbours
+/// a level below. The even columns are a level above the odd ones, so the neighbours below depend on the parity of the column.
+struct FCC110Stencil
+{
+    static constexpr int iVariants = 2;
+    static constexpr int iOffsets = 8;
+    static constexpr StencilOffset aOffsets[ iVariants ][ iOffsets ] = {
+        {
+            { -1,  0, NeighbourTable::SAME, Site::NORTH },
+            {  1,  0, NeighbourTable::SAME, Site::SOUTH },
+            {  0, -2, NeighbourTable::SAME, Site::WEST },
+            {  0,  2, NeighbourTable::SAME, Site::EAST },
+            { -1,  1, NeighbourTable::BELOW, Site::EAST_UP },
+            { -1, -1, NeighbourTable::BELOW, Site::WEST_UP },
+            {  0, -1, NeighbourTable::BELOW, Site::WEST_DOWN },
+            {  0,  1, NeighbourTable::BELOW, Site::EAST_DOWN }
+        },
+        {
+            { -1,  0, NeighbourTable::SAME, Site::NORTH },
+            {  1,  0, NeighbourTable::SAME, Site::SOUTH },
+            {  0, -2, NeighbourTable::SAME, Site::WEST },
+            {  0,  2, NeighbourTable::SAME, Site::EAST },
+            {  0,  1, NeighbourTable::BELOW, Site::EAST_UP },
+            {  0, -1, NeighbourTable::BELOW, Site::WEST_UP },
+            {  1,  1, NeighbourTable::BELOW, Site::EAST_DOWN },
+            {  1, -1, NeighbourTable::BELOW, Site::WEST_DOWN }
+        }
+    };
+
+    static constexpr int variant( int, int column ){ return column%2; }
+};
+
+/// The FCC(111) lattice: the six neighbours of the site. The sites two rows apart are only positions.
+struct FCC111Stencil
+{
+    static constexpr int iVariants = 1;
+    static constexpr int iOffsets = 8;
+    static constexpr StencilOffset aOffsets[ iVariants ][ iOffsets ] = {
+        {
+            {  0, -2, NeighbourTable::NEIGHS, Site::EAST },
+            {  0,  2, NeighbourTable::NEIGHS, Site::WEST },
+            {  1, -1, NeighbourTable::NEIGHS, Site::EAST_DOWN },
+            {  1,  1, NeighbourTable::NEIGHS, Site::WEST_DOWN },
+            { -1, -1, NeighbourTable::NEIGHS, Site::EAST_UP },
+            { -1,  1, NeighbourTable::NEIGHS, Site::WEST_UP },
+            { -2,  0, NeighbourTable::LISTS, Site::NORTH },
+            {  2,  0, NeighbourTable::LISTS, Site::SOUTH }
+        }
+    };
+
+    static constexpr int variant( int, int ){ return 0; }
+};
+
+/// The HCP lattice: the six neighbours at the same level.
+struct HCPStencil
+{
+    static constexpr int iVariants = 1;
+    static constexpr int iOffsets = 6;
+    static constexpr StencilOffset aOffsets[ iVariants ][ iOffsets ] = {
+        {
+            { -1,  0, NeighbourTable::NEIGHS, Site::WEST_UP },
+            {  1,  0, NeighbourTable::NEIGHS, Site::WEST_DOWN },
+            {  0,  1, NeighbourTable::NEIGHS, Site::EAST },
+            {  0, -1, NeighbourTable::NEIGHS, Site::WEST },
+            { -1,  1, NeighbourTable::NEIGHS, Site::EAST_UP },
+            {  1,  1, NeighbourTable::NEIGHS, Site::EAST_DOWN }
+        }
+    };
+
+    static constexpr int variant( int, int ){ return 0; }
+};
+
+/// Adds the neighbours of the sites (the site of row i and column j is at i*columns + j) to the table and sets their positions
+/// as the stencil describes them. The lattice must be at least as large as the stencil in both directions.
+template< class Stencil >
+void buildNeighbours( NeighbourTable& table, const vector<Site*>& sites, int rows, int columns )
+{
+    for ( int i = 0; i < rows; i++ ){
+        for ( int j = 0; j < columns; j++ ){
+            Site* s = sites[ i*columns + j ];
+
+            for ( const StencilOffset& offset:Stencil::aOffsets[ Stencil::variant( i, j ) ] ){
+                Site* neigh = sites[ wrap( i + offset.iRow, rows )*columns + wrap( j + offset.iColumn, columns ) ];
+
+                if ( offset.list != NeighbourTable::LISTS )
+                    table.add( s->getID(), offset.list, neigh->getID() );
+
+                if ( offset.iPosition != StencilOffset::NONE )
+                    s->setNeighPosition( neigh, (Site::NeighPoisition)offset.iPosition );
+            }
+        }
+    }
+}
+
+/// Returns the number of the neighbours of the site that are at least as high as the site.
+/// The number of the neighbours is the one of the stencil, so the loop has a fixed trip count.
+template< class Stencil >
+int countNeighbours( Site* s )
+{
+    constexpr int iNeighs = stencilSize< Stencil >( NeighbourTable::NEIGHS );
+
+    NeighbourSpan neighs = s->getNeighs();
+    int iHeight = s->getHeight();
+    int iCount = 0;
+    for ( int i = 0; i < iNeighs; i++ )
+        iCount += neighs[ i ]->getHeight() >= iHeight;
+
+    return iCount;
+}
+
+/// Returns the number of the neighbours of the site that are at least as high as the site (for any number of neighbours).
+inline int countNeighbours( Site* s )
+{
+    int iHeight = s->getHeight();
+    int iCount = 0;
+    for ( Site* neigh:s->getNeighs() )
+        iCount += neigh->getHeight() >= iHeight;
+
+    return iCount;
+}
+
+}
+
+#endif // STENCIL_H
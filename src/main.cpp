@@ -35,6 +35,10 @@
 #include "lattice.h"
 #include "process.h"
 #include "apothesis.h"
+#include "parameters.h"
+#include "ensemble.h"
+#include "sweep.h"
+#include "errorhandler.h"
 
 /////////////////////////
 //#include "SurfaceReaction.h"
@@ -47,18 +51,69 @@ using namespace MicroProcesses;
 
 int main( int argc, char* argv[] )
 {
+    Apothesis* apothesis = 0;
 
-    Apothesis* apothesis = new Apothesis( argc, argv );
+    try {
+        apothesis = new Apothesis( argc, argv );
+        apothesis->readInput();
 
-    cout << "Initiating Apothesis" << endl;
-    apothesis->init();
+        //A sweep performs every point in its own instance which copies the lattice and the partition of this one
+        if ( !apothesis->pParameters->getSweeps().empty() ){
+            if ( apothesis->pParameters->getEnsembleRuns() > 0 ){
+                apothesis->pErrorHandler->error_simple_msg("An ensemble cannot be combined with a sweep.");
+                EXIT
+            }
 
-    cout << "Apothesis runnning ..." << endl;
-    apothesis->exec();
-    cout << "Apothesis finished succesfully." << endl;
+            apothesis->build();
+            Sweep sweep( argc, argv, apothesis, apothesis->pParameters->getSweeps(), apothesis->pParameters->getThreads() );
 
-    if ( apothesis )
-      delete apothesis;
-}
+            cout << "Apothesis running a sweep of " << sweep.getNumPoints() << " points ..." << endl;
+            int iFailed = sweep.exec();
+
+            delete apothesis;
+            apothesis = 0;
+
+            if ( iFailed > 0 ){
+                cout << iFailed << " of " << sweep.getNumPoints() << " points failed." << endl;
+                return EXIT_FAILURE;
+            }
+
+            cout << "Apothesis finished succesfully." << endl;
+            return EXIT_SUCCESS;
+        }
+
+        //An ensemble performs every run in its own instance so this one is only used for reading the input
+        int iRuns = apothesis->pParameters->getEnsembleRuns();
+        if ( iRuns > 0 ){
+            int iSeed = apothesis->pParameters->getRandGenInit() != 0 ? apothesis->pParameters->getRandGenInit() : time( nullptr );
+            Ensemble ensemble( argc, argv, iRuns, apothesis->pParameters->getThreads(), iSeed );
 
+            delete apothesis;
+            apothesis = 0;
 
+            cout << "Apothesis running an ensemble of " << iRuns << " runs ..." << endl;
+            int iFailed = ensemble.exec();
+            if ( iFailed > 0 ){
+                cout << iFailed << " of " << iRuns << " runs failed." << endl;
+                return EXIT_FAILURE;
+            }
+
+            cout << "Apothesis finished succesfully." << endl;
+            return EXIT_SUCCESS;
+        }
+
+        cout << "Initiating Apothesis" << endl;
+        apothesis->init();
+
+        cout << "Apothesis runnning ..." << endl;
+        apothesis->exec();
+        cout << "Apothesis finished succesfully." << endl;
+    }
+    catch ( const ApothesisError& error ){
+        cout << error.what() << endl;
+        delete apothesis;
+        return EXIT_FAILURE;
+    }
+
+    delete apothesis;
+}
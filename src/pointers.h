@@ -47,7 +47,7 @@ public:
 
 protected:
     /// Pointers to the classes of apothesis.cpp
-    Apothesis*& m_apothesis;
+    Apothesis* m_apothesis;
 
     /// Pointers to the classes of apothesis.cpp
     Lattice*& m_lattice;
@@ -15,6 +15,9 @@
 //    along with this program.  If not, see <https://www.gnu.org/licenses/>.
 //============================================================================
 #include "adsorption.h"
+#include "CoarseGrained.h"
+
+#include <cmath>
 
 namespace MicroProcesses
 {
@@ -52,17 +55,30 @@ void Adsorption::init( vector<string> params )
         EXIT
     }
 
-    //Create the rule for the adsoprtion process.
+    m_iAdsorbed = m_pUtilParams->getSpeciesRegistry().add( m_sAdsorbed );
+
+    //Create the rule for the adsoprtion process and declare what the rule reads.
     if ( m_iNumSites == 1 && isPartOfGrowth( m_sAdsorbed ) ){
         setUncoAccepted( true );
         m_fRules = &Adsorption::uncoRule;
+        m_iReads = NONE;
+        m_iRadius = 0;
     }
-    else if ( m_iNumSites > 1 && isPartOfGrowth( m_sAdsorbed ) )
+    else if ( m_iNumSites > 1 && isPartOfGrowth( m_sAdsorbed ) ){
         m_fRules = &Adsorption::basicRule;
-    else if ( m_iNumSites == 1 && !isPartOfGrowth( m_sAdsorbed ) )
+        m_iReads = NEIGHBOURS;
+        m_iRadius = 0;
+    }
+    else if ( m_iNumSites == 1 && !isPartOfGrowth( m_sAdsorbed ) ){
         m_fRules = &Adsorption::multiSpeciesSimpleRule;
-    else if ( m_iNumSites > 1 && !isPartOfGrowth( m_sAdsorbed ) )
+        m_iReads = OCCUPANCY;
+        m_iRadius = 0;
+    }
+    else if ( m_iNumSites > 1 && !isPartOfGrowth( m_sAdsorbed ) ){
         m_fRules = &Adsorption::multiSpeciesRule;
+        m_iReads = OCCUPANCY | HEIGHT;
+        m_iRadius = 1;
+    }
     else {
         m_error->error_simple_msg("The rule for this process has not been defined.");
         EXIT
@@ -84,6 +100,22 @@ void Adsorption::init( vector<string> params )
         EXIT
     }
 
+    //On a coarse-grained lattice the cells adsorb in their vacant sites (see coarseEvents). In PVD every site of a cell
+    //adsorbs on top of it (the height of the cell is the sum of the heights of its sites).
+    if ( m_pCoarse ){
+        if ( m_iNumSites > 1 && isPartOfGrowth( m_sAdsorbed ) ){
+            m_error->error_simple_msg("The coarse-grained lattice does not resolve the coordination of the sites | " + m_sProcName );
+            EXIT
+        }
+
+        if ( !isPartOfGrowth( m_sAdsorbed ) ){
+            m_fRules = &Adsorption::coarseRule;
+            m_fPerform = &Adsorption::coarseAdsorption;
+            m_iReads = OCCUPANCY;
+            m_iRadius = 0;
+        }
+    }
+
     (this->*m_fType)();
 }
 
@@ -94,7 +126,7 @@ void Adsorption::constantType(){
 bool Adsorption::uncoRule( Site* ){ return true; }
 
 bool Adsorption::basicRule( Site* s){
-    if ( calculateNeighbors(s) == m_iNumSites)
+    if ( s->getNeighsNum() == m_iNumSites)
         return true;
 
     return false;
@@ -121,6 +153,45 @@ bool Adsorption::multiSpeciesRule( Site* s){
     return true;
 }
 
+bool Adsorption::coarseRule( Site* s ){
+    return coarseEvents( s ) > 0.0;
+}
+
+double Adsorption::coarseEvents( Site* s ){
+    if ( isPartOfGrowth( m_sAdsorbed ) )
+        return m_pCoarse->getSitesPerCell();
+
+    int iVacant = m_pCoarse->getVacant( s );
+    if ( m_iNumSites == 1 )
+        return iVacant;
+
+    if ( iVacant < m_iNumSites )
+        return 0.0;
+
+    //The vacant sites with exactly m_iNumVacant vacant neighbours when every other site of the cell is vacant with the same probability
+    int q = m_pCoarse->getSitesPerCell();
+    int z = s->getNeighs().size();
+    double p = (double)( iVacant - 1 )/( q - 1 );
+
+    double dChoices = 1.0;
+    for ( int i = 0; i < m_iNumVacant; i++ )
+        dChoices *= (double)( z - i )/( i + 1 );
+
+    return iVacant*dChoices*pow( p, m_iNumVacant )*pow( 1.0 - p, z - m_iNumVacant );
+}
+
+void Adsorption::coarseAdsorption( Site* s ){
+    m_iWrites = OCCUPANCY | LABEL;
+
+    m_pCoarse->changeCount( s, m_iAdsorbed, m_iNumSites );
+
+    //The hops to the cell start from its neighbours
+    m_seAffectedSites.insert( s );
+    m_seModifiedSites.insert( s );
+    for ( Site* neigh:s->getNeighs() )
+        m_seAffectedSites.insert( neigh );
+}
+
 int Adsorption::countVacantSites( Site* s){
     int iCount = 0;
     for (Site* neigh:s->getNeighs() ){
@@ -147,33 +218,37 @@ void Adsorption::arrheniusType(){}
 
 bool Adsorption::rules( Site* s )
 {
-    (this->*m_fRules)(s);
+    return (this->*m_fRules)(s);
 }
 
 void Adsorption::signleSpeciesAdsorption(Site *s) {
     //Needs check!
-    s->increaseHeight( 1 );
-    calculateNeighbors( s );
+    m_iWrites = HEIGHT | NEIGHBOURS;
+
+    m_pLattice->changeHeight( s, 1 );
     m_seAffectedSites.insert( s ) ;
+    m_seModifiedSites.insert( s );
 
     for ( Site* neigh:s->getNeighs() ) {
-        calculateNeighbors( neigh );
         m_seAffectedSites.insert( neigh );
+        m_seModifiedSites.insert( neigh );
     }
 
-    vector<Site*> neighs = s->getNeighs();
+    //The sites still available are removed from a copy of the neighbours
+    NeighbourSpan vNeighs = s->getNeighs();
+    vector<Site*> neighs( vNeighs.begin(), vNeighs.end() );
 
     // Because one is already occupied above
     for ( int i = 0 ; i < m_iNumSites-1; i++) {
         int ranNum = m_pRandomGen->getIntRandom( 0,  neighs.size()-1 );
         Site* neigh = neighs[ ranNum ];
-        neigh->increaseHeight(1);
-        calculateNeighbors( neigh );
+        m_pLattice->changeHeight( neigh, 1 );
         m_seAffectedSites.insert( neigh ) ;
+        m_seModifiedSites.insert( neigh );
 
         for ( Site* neigh2:neigh->getNeighs() ) {
-            calculateNeighbors( neigh2 );
             m_seAffectedSites.insert( neigh2 );
+            m_seModifiedSites.insert( neigh2 );
         }
 
         neighs.erase( find( neighs.begin(), neighs.end(), neigh ) );
@@ -181,38 +256,48 @@ void Adsorption::signleSpeciesAdsorption(Site *s) {
 }
 
 void Adsorption::signleSpeciesSimpleAdsorption(Site *s) {
-    s->increaseHeight( 1 );
-    calculateNeighbors( s );
+    m_iWrites = HEIGHT | NEIGHBOURS;
+
+    m_pLattice->changeHeight( s, 1 );
     m_seAffectedSites.insert( s ) ;
+    m_seModifiedSites.insert( s );
 
     for ( Site* neigh:s->getNeighs() ) {
-        calculateNeighbors( neigh );
         m_seAffectedSites.insert( neigh );
+        m_seModifiedSites.insert( neigh );
     }
 }
 
 void Adsorption::multiSpeciesSimpleAdsorption(Site *s) {
     //Here must hold the previous site in order to appear in case of multiple species forming the growing film
+    m_iWrites = OCCUPANCY | LABEL;
+
     s->setOccupied( true );
-    s->setBelowLabel( s->getLabel() );
-    s->setLabel( m_sAdsorbed );
+    s->setBelowSpecies( s->getSpecies() );
+    m_pLattice->changeSpecies( s, m_iAdsorbed );
 
     m_seAffectedSites.insert( s );
+    m_seModifiedSites.insert( s );
     for ( Site* neigh:s->getNeighs() )
         m_seAffectedSites.insert( neigh ) ;
 }
 
 void Adsorption::multiSpeciesAdsorption(Site *s) {
     //Here must hold the previous site in order to appear in case of multiple species forming the growing film
+    m_iWrites = OCCUPANCY | LABEL;
+
     s->setOccupied( true );
-    s->setBelowLabel( s->getLabel() );
-    s->setLabel( m_sAdsorbed );
+    s->setBelowSpecies( s->getSpecies() );
+    m_pLattice->changeSpecies( s, m_iAdsorbed );
 
     m_seAffectedSites.insert( s );
+    m_seModifiedSites.insert( s );
     for ( Site* neigh:s->getNeighs() )
         m_seAffectedSites.insert( neigh ) ;
 
-    vector<Site*> neighs = s->getNeighs();
+    //The sites still available are removed from a copy of the neighbours
+    NeighbourSpan vNeighs = s->getNeighs();
+    vector<Site*> neighs( vNeighs.begin(), vNeighs.end() );
 
     int iNum = 0;
     while (iNum != m_iNumSites-1 ) {
@@ -222,10 +307,11 @@ void Adsorption::multiSpeciesAdsorption(Site *s) {
 
         if ( !neigh->isOccupied() && neigh->getHeight() == s->getHeight() ) {
             neigh->setOccupied( true );
-            neigh->setBelowLabel( neigh->getLabel() );
-            neigh->setLabel( m_sAdsorbed );
+            neigh->setBelowSpecies( neigh->getSpecies() );
+            m_pLattice->changeSpecies( neigh, m_iAdsorbed );
 
             m_seAffectedSites.insert( neigh ) ;
+            m_seModifiedSites.insert( neigh );
             for ( Site* neigh2:neigh->getNeighs() )
                 m_seAffectedSites.insert( neigh2 );
 
@@ -239,40 +325,12 @@ void Adsorption::multiSpeciesAdsorption(Site *s) {
 
 void Adsorption::perform( Site* s )
 {
+    m_seAffectedSites.clear();
+    m_seModifiedSites.clear();
+    m_iWrites = NONE;
     (this->*m_fPerform)(s);
 }
 
-int Adsorption::calculateNeighbors(Site* s)
-{
-    int neighs = 0;
-
-    if (m_pLattice->hasSteps() ){
-        for ( Site* neigh:s->getNeighs() ) {
-            if ( s->isLowerStep() && neigh->isHigherStep() ){
-                if ( neigh->getHeight() >= s->getHeight() + m_pLattice->getStepDiff() + 1 )
-                    neighs++;
-            }
-            else if ( neigh->isLowerStep() && s->isHigherStep() ){
-                if ( neigh->getHeight() >= s->getHeight() - m_pLattice->getStepDiff() + 1 )
-                    neighs++;
-            }
-            else {
-                if ( neigh->getHeight() >= s->getHeight() )
-                    neighs++;
-            }
-        }
-    } else {
-        int neighs = 0;
-        for ( Site* neigh:s->getNeighs() ) {
-            if ( neigh->getHeight() >= s->getHeight() )
-                neighs++;
-        }
-    }
-
-    s->setNeighsNum( neighs );
-    return neighs;
-}
-
 bool Adsorption::isInLowerStep(Site* s)
 {
     for (int j = 0; j < m_pLattice->getY(); j++)
@@ -293,4 +351,6 @@ bool Adsorption::isInHigherStep(Site* s)
 
 double Adsorption::getRateConstant(){ return m_dProb; }
 
+double Adsorption::getRate( Site* s ){ return m_pCoarse ? m_dProb*coarseEvents( s ) : m_dProb; }
+
 }
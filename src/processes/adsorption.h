@@ -33,6 +33,11 @@ public:
     void init( vector<string> params ) override;
     double getRateConstant() override;
 
+    /// On a coarse-grained lattice the rate of a cell is the rate constant times the number of its sites where the adsorption can happen.
+    double getRate( Site* ) override;
+
+    Process* clone() override { return new Adsorption( *this ); }
+
     inline void setTargetSite( Site* site ){ m_Site = site;}
     inline Site* getTargetSite(){ return m_Site; }
 
@@ -94,6 +99,16 @@ private:
     /// Counts the vacants sites
     int countVacantSites( Site* s);
 
+    /// For a coarse-grained lattice the cell must have sites where the adsorption can happen.
+    bool coarseRule( Site* s );
+
+    /// Returns the expected number of the sites of the cell where the adsorption can happen: its vacant sites
+    /// (with as many vacant neighbours as the process needs if it occupies more sites) or all its sites in PVD.
+    double coarseEvents( Site* s );
+
+    /// The process is CVD or ALD on a coarse-grained lattice: the adsorbed species occupies vacant sites of the cell
+    void coarseAdsorption( Site* s );
+
     /// Checks if the site is in lower step (only for simple cubic lattice)
     bool isInLowerStep( Site* s );
 
@@ -103,9 +118,6 @@ private:
     ///The site that the process will be performed
     Site* m_Site;
 
-    /// Calculates the neighbors of a given site
-    int calculateNeighbors(Site*);
-
     /// For simple adsorption:
     ///The sticking coefficient [-]
     double m_dStick;
@@ -122,6 +134,9 @@ private:
     /// The species to be asdorbed
     string m_sAdsorbed;
 
+    /// The ID of the species to be adsorbed
+    int m_iAdsorbed;
+
     /// The adsorption rate given as input from the user with the constant keyword
     double m_dAdsorptionRate;
 
@@ -15,13 +15,14 @@
 //    along with this program.  If not, see <https://www.gnu.org/licenses/>.
 //============================================================================
 #include "desorption.h"
+#include "CoarseGrained.h"
 
 namespace MicroProcesses
 {
 
 REGISTER_PROCESS_IMPL(Desorption);
 
-Desorption::Desorption():m_bAllNeihs(false){}
+Desorption::Desorption():m_iReactant(-1), m_bAllNeihs(false){}
 Desorption::~Desorption(){}
 
 void Desorption::init(vector<string> params)
@@ -49,13 +50,22 @@ void Desorption::init(vector<string> params)
     //Set the type of the process
     (this->*m_fType)();
 
-    //Create the rule for the adsoprtion process.
-    if ( m_bAllNeihs && isPartOfGrowth( m_sDesorbed ) )
+    //Create the rule for the adsoprtion process and declare what the rule reads.
+    if ( m_bAllNeihs && isPartOfGrowth( m_sDesorbed ) ){
         m_fRules = &Desorption::allRule;
-    else if ( !m_bAllNeihs &&  isPartOfGrowth( m_sDesorbed ) )
+        m_iReads = NEIGHBOURS;
+        m_iRadius = 0;
+    }
+    else if ( !m_bAllNeihs &&  isPartOfGrowth( m_sDesorbed ) ){
         m_fRules = &Desorption::basicRule;
-    else
+        m_iReads = NONE;
+        m_iRadius = 0;
+    }
+    else {
         m_fRules = &Desorption::difSpeciesRule;
+        m_iReads = OCCUPANCY;
+        m_iRadius = 0;
+    }
 
 
     //Check what process should be performed.
@@ -65,6 +75,28 @@ void Desorption::init(vector<string> params)
         m_fPerform = &Desorption::singleSpeciesSimpleDesorption;
     else
         m_fPerform = &Desorption::multiSpeciesSimpleDesorption;
+
+    //On a coarse-grained lattice the cells desorb their sites with the desorbed species (see coarseEvents).
+    //In PVD every site of a cell desorbs from its top.
+    if ( m_pCoarse ){
+        if ( m_bAllNeihs ){
+            m_error->error_simple_msg("The coarse-grained lattice does not resolve the coordination of the sites | " + m_sProcName );
+            EXIT
+        }
+
+        if ( !isPartOfGrowth( m_sDesorbed ) ){
+            if ( m_sReactant.empty() || m_iNumSites > 2 ){
+                m_error->error_simple_msg("On the coarse-grained lattice a desorption must desorb one or two sites of a surface species | " + m_sProcName );
+                EXIT
+            }
+
+            m_iReactant = m_pUtilParams->getSpeciesRegistry().add( m_sReactant );
+            m_fRules = &Desorption::coarseRule;
+            m_fPerform = &Desorption::coarseDesorption;
+            m_iReads = OCCUPANCY | LABEL;
+            m_iRadius = 0;
+        }
+    }
 }
 
 bool Desorption::difSpeciesRule( Site* s){
@@ -94,11 +126,11 @@ void Desorption::arrheniusType()
 
 bool Desorption::rules( Site* s)
 {
-    (this->*m_fRules)(s);
+    return (this->*m_fRules)(s);
 }
 
 bool Desorption::allRule( Site* s){
-    if ( calculateNeighbors( s ) == m_iNumNeighs )
+    if ( s->getNeighsNum() == m_iNumNeighs )
         return true;
     return false;
 }
@@ -110,69 +142,71 @@ bool Desorption::basicRule( Site* s){
 
 void Desorption::perform( Site* s)
 {
+    m_seAffectedSites.clear();
+    m_seModifiedSites.clear();
+    m_iWrites = NONE;
     (this->*m_fPerform)(s);
 }
 
+bool Desorption::coarseRule( Site* s ){
+    return coarseEvents( s ) > 0.0;
+}
+
+double Desorption::coarseEvents( Site* s ){
+    if ( isPartOfGrowth( m_sDesorbed ) )
+        return m_pCoarse->getSitesPerCell();
+
+    int iCount = m_pCoarse->getCount( s, m_iReactant );
+    if ( m_iNumSites == 1 )
+        return iCount;
+
+    //The pairs of neighbouring sites with the species when every other site of the cell has it with the same probability
+    int q = m_pCoarse->getSitesPerCell();
+    if ( iCount < 2 )
+        return 0.0;
+
+    return 0.5*iCount*s->getNeighs().size()*(double)( iCount - 1 )/( q - 1 );
+}
+
+void Desorption::coarseDesorption( Site* s ){
+    m_iWrites = OCCUPANCY | LABEL;
+
+    m_pCoarse->changeCount( s, m_iReactant, -m_iNumSites );
+
+    //The hops to the cell start from its neighbours
+    m_seAffectedSites.insert( s );
+    m_seModifiedSites.insert( s );
+    for ( Site* neigh:s->getNeighs() )
+        m_seAffectedSites.insert( neigh );
+}
+
 void Desorption::singleSpeciesSimpleDesorption(Site *s) {
     //For PVD results
-    s->decreaseHeight( 1 );
-    calculateNeighbors( s ) ;
+    m_iWrites = HEIGHT | NEIGHBOURS;
+
+    //Only the coordination numbers of the site and its neighbours change
+    m_pLattice->changeHeight( s, -1 );
     m_seAffectedSites.insert( s );
+    m_seModifiedSites.insert( s );
     for ( Site* neigh:s->getNeighs() ) {
-        calculateNeighbors( neigh );
         m_seAffectedSites.insert( neigh );
-
-        for ( Site* firstNeigh:neigh->getNeighs() ){
-            firstNeigh->setNeighsNum( calculateNeighbors( firstNeigh ) );
-            m_seAffectedSites.insert( firstNeigh );
-        }
+        m_seModifiedSites.insert( neigh );
     }
 }
 
 void Desorption::multiSpeciesSimpleDesorption(Site *s)
 {
+    m_iWrites = OCCUPANCY | LABEL;
+
     s->setOccupied( false );
-    s->setLabel( s->getBelowLabel() );
+    m_pLattice->changeSpecies( s, s->getBelowSpecies() );
 
     m_seAffectedSites.insert( s );
+    m_seModifiedSites.insert( s );
     for ( Site* neigh:s->getNeighs() )
         m_seAffectedSites.insert( neigh );
 }
 
-int Desorption::calculateNeighbors(Site* s)
-{
-    int neighs = 0;
-
-    if ( m_pLattice->hasSteps() ){
-        for ( Site* neigh:s->getNeighs() ) {
-            if ( s->isLowerStep() && neigh->isHigherStep() ){
-                if ( neigh->getHeight() >= s->getHeight() + m_pLattice->getStepDiff() + 1 )
-                    neighs++;
-            }
-            else if ( neigh->isLowerStep() && s->isHigherStep() ){
-                if ( neigh->getHeight() >= s->getHeight() - m_pLattice->getStepDiff() + 1 )
-                    neighs++;
-            }
-            else {
-                if ( neigh->getHeight() >= s->getHeight() )
-                    neighs++;
-            }
-        }
-
-        s->setNeighsNum( neighs );
-    }
-    else {
-        for ( Site* neigh:s->getNeighs() ) {
-            if ( neigh->getHeight() >= s->getHeight() )
-                neighs++;
-        }
-
-        s->setNeighsNum( neighs );
-    }
-
-    return neighs;
-}
-
 bool Desorption::isInLowerStep(Site* s)
 {
     for (int j = 0; j < m_pLattice->getY(); j++)
@@ -195,4 +229,6 @@ bool Desorption::isInHigherStep(Site* s)
 
 double Desorption::getRateConstant(){ return m_dProb; }
 
+double Desorption::getRate( Site* s ){ return m_pCoarse ? m_dProb*coarseEvents( s ) : m_dProb; }
+
 }
@@ -32,6 +32,11 @@ public:
     inline Site* getTargetSite(){ return m_Site; }
 
     double getRateConstant() override;
+
+    /// On a coarse-grained lattice the rate of a cell is the rate constant times the number of its sites (or pairs of sites) that can desorb.
+    double getRate( Site* ) override;
+
+    Process* clone() override { return new Desorption( *this ); }
     bool rules( Site* s) override;
     void perform( Site* ) override;
     void init(vector<string> params) override;
@@ -39,6 +44,9 @@ public:
     /// Sets the specific adsorption species label according to the input
     void setDesorbed(string desorbed){ m_sDesorbed = desorbed;}
 
+    /// Sets the surface species that desorbs and the number of its sites that desorb together (e.g. 2 for 2O* -> O2 + 2*).
+    inline void setReactant( string reactant, int sites ){ m_sReactant = reactant; m_iNumSites = sites; }
+
     /// If keyrowd "all" is added then this is true
     inline void setAllNeighs( bool all ){  m_bAllNeihs = all; }
 
@@ -77,18 +85,29 @@ private:
     /// The process is CVD or ALD
     void multiSpeciesSimpleDesorption(Site*);
 
+    /// For a coarse-grained lattice the cell must have sites that can desorb.
+    bool coarseRule( Site* s );
+
+    /// Returns the expected number of the sites (or of the pairs of neighbouring sites) of the cell that can desorb
+    /// i.e. those with the surface species or all its sites in PVD.
+    double coarseEvents( Site* s );
+
+    /// The process is CVD or ALD on a coarse-grained lattice: the sites of the surface species in the cell become vacant
+    void coarseDesorption( Site* s );
+
     ///The site that adsorption will be performed
     Site* m_Site;
 
-    /// A member function to calculate the neighbors of a given site
-    int calculateNeighbors(Site*);
-
     /// The number of neighbours of this process
     int m_iNumNeighs;
 
     /// The species to be asdorbed
     string m_sDesorbed;
 
+    /// The surface species that desorbs and its ID (it is registered only for a coarse-grained lattice)
+    string m_sReactant;
+    int m_iReactant;
+
     /// If the user has "all" keyword this is set to true
     bool m_bAllNeihs;
 
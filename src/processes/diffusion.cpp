@@ -16,13 +16,14 @@
 //============================================================================
 
 #include "diffusion.h"
+#include "CoarseGrained.h"
 
 namespace MicroProcesses
 {
 
 REGISTER_PROCESS_IMPL(Diffusion)
 
-Diffusion::Diffusion(){}
+Diffusion::Diffusion():m_iDiffused(-1), m_bAllNeihs(false){}
 Diffusion::~Diffusion(){}
 
 
@@ -34,7 +35,7 @@ void Diffusion::init(vector<string> params)
     //In the first must always be the type
     m_sType = any_cast<string>(m_vParams[ 0 ]);
     if ( m_sType.compare("arrhenius") == 0 ){
-        m_iNumNeighs = stoi( m_vParams[3] );
+        m_iNumNeighs = stoi( m_vParams[4] );
         arrhenius( stod(m_vParams[ 1 ]), stod(m_vParams[ 2 ]), stod(m_vParams[ 3 ]), m_pUtilParams->getTemperature(), m_iNumNeighs+1 );
     }
     else {
@@ -42,28 +43,61 @@ void Diffusion::init(vector<string> params)
         EXIT
     }
 
-    //Create the rule for the adsoprtion process.
-    if ( m_bAllNeihs )
-        m_fRules = &Diffusion::mf_allRule;
-    else
-        m_fRules = &Diffusion::mf_basicRule;
-
-    //Check what process should be performed.
-    //Desorption in PVD will lead to increasing the height of the site
-    //Desorption in CVD will change the label of the site
-    if ( isPartOfGrowth() )
+    //Every hop from a site to a neighbour is an event with the rate of the process.
+    //In PVD the rules read the height of the site (and the number of its neighbours i.e. its coordination).
+    //In CVD/ALD the rules read the species of the site and of the neighbour (and their heights).
+    m_bPair = true;
+    if ( isPartOfGrowth() ){
         m_fPerform = &Diffusion::mf_performPVD;
-    else
+        m_iRadius = 0;
+
+        if ( m_bAllNeihs ){
+            m_fRules = &Diffusion::mf_allRule;
+            m_iReads = HEIGHT | NEIGHBOURS;
+        }
+        else {
+            m_fRules = &Diffusion::mf_basicRule;
+            m_iReads = HEIGHT;
+        }
+
+        //Only the deposited atoms hop i.e. the substrate is the lattice as it was built
+        m_vSubstrate.assign( m_pLattice->getSize(), 0 );
+        for ( Site* s:m_pLattice->getSites() )
+            m_vSubstrate[ s->getID() ] = s->getHeight();
+    }
+    else {
+        m_iDiffused = m_pUtilParams->getSpeciesRegistry().add( m_sDiffused + "*" );
         m_fPerform = &Diffusion::mf_performCVDALD;
+        m_iReads = OCCUPANCY | LABEL | HEIGHT;
+        m_iRadius = 1;
+
+        if ( m_bAllNeihs )
+            m_fRules = &Diffusion::mf_allSpeciesRule;
+        else
+            m_fRules = &Diffusion::mf_speciesRule;
+    }
+
+    //On a coarse-grained lattice the hops inside a cell do not change it so only the hops between neighbouring cells
+    //are performed (see getPairRate). In PVD the top atom of a site of the cell moves on a site of the neighbour.
+    if ( m_pCoarse ){
+        if ( m_bAllNeihs ){
+            m_error->error_simple_msg("The coarse-grained lattice does not resolve the coordination of the sites | " + m_sProcName );
+            EXIT
+        }
+
+        if ( !isPartOfGrowth() ){
+            m_fRules = &Diffusion::mf_coarseRule;
+            m_fPerform = &Diffusion::mf_performCoarse;
+            m_iReads = OCCUPANCY | LABEL;
+        }
+    }
 
     cout << endl;
 }
 
 bool Diffusion::isPartOfGrowth(){
-    if (std::find(m_pUtilParams->getGrowthSpecies().begin(), m_pUtilParams->getGrowthSpecies().end(), m_sDiffused ) != m_pUtilParams->getGrowthSpecies().end())
-        return true;
-
-    return false;
+    //The growth species are kept as surface species i.e. with their "*"
+    return Process::isPartOfGrowth( m_sDiffused + "*" );
 }
 
 void Diffusion::arrhenius(double v0, double E, double Em, double T,  int n)
@@ -93,96 +127,100 @@ void Diffusion::arrhenius(double v0, double E, double Em, double T,  int n)
     double k = m_pUtilParams->dkBoltz;
     E = E/m_pUtilParams->dAvogadroNum;
     Em = Em/m_pUtilParams->dAvogadroNum;
-    double A = exp(E-Em)/(k*T);
+    double A = exp((E-Em)/(k*T));
     m_dProb = v0*A*exp(-(double)n*E/(k*T));
 }
 
-bool Diffusion::mf_allRule(Site* s){
-    if ( s->getNeighsNum() == m_iNumNeighs )
+bool Diffusion::mf_allRule(Site* s, Site* neigh){
+    if ( mf_basicRule( s, neigh ) && s->getNeighsNum() == m_iNumNeighs )
         return true;
-    return false;}
+    return false;
+}
+
+bool Diffusion::mf_basicRule(Site* s, Site*){
+    return s->getHeight() > m_vSubstrate[ s->getID() ];
+}
+
+bool Diffusion::mf_speciesRule(Site* s, Site* neigh){
+    return s->isOccupied() && s->getSpecies() == m_iDiffused && !neigh->isOccupied() && s->getHeight() == neigh->getHeight();
+}
+
+bool Diffusion::mf_allSpeciesRule(Site* s, Site* neigh){
+    if ( !mf_speciesRule( s, neigh ) )
+        return false;
+
+    //The bonds of the diffused species are counted as the occupied neighbours of the site
+    int iCount = 0;
+    for ( Site* s1:s->getNeighs() )
+        if ( s1->isOccupied() )
+            iCount++;
 
-bool Diffusion::mf_basicRule(Site* s){
-    return true;
+    return iCount == m_iNumNeighs;
 }
 
-void Diffusion::mf_performCVDALD( Site* s){
+bool Diffusion::mf_coarseRule(Site* s, Site* neigh){
+    return m_pCoarse->getCount( s, m_iDiffused ) > 0 && m_pCoarse->getVacant( neigh ) > 0;
 }
 
-void Diffusion::mf_performPVD( Site* s){
-    //----- This is desorption ------------------------------------------------------------->
-    s->decreaseHeight( 1 );
-    mf_calculateNeighbors( s ) ;
+void Diffusion::mf_affect( Site* s, bool neighsModified ){
     m_seAffectedSites.insert( s );
+    m_seModifiedSites.insert( s );
     for ( Site* neigh:s->getNeighs() ) {
-        mf_calculateNeighbors( neigh );
         m_seAffectedSites.insert( neigh );
-
-        for ( Site* firstNeigh:neigh->getNeighs() ){
-            firstNeigh->setNeighsNum( mf_calculateNeighbors( firstNeigh ) );
-            m_seAffectedSites.insert( firstNeigh );
-        }
-    }
-    //--------------------------------------------------------------------------------------<
-
-    // Random pick a site to re-adsorpt
-    Site* adsorbSite;
-    if ( m_pRandomGen )
-        adsorbSite = s->getNeighs().at( m_pRandomGen->getIntRandom(0, m_iNumNeighs-2) );
-    else{
-        cout << "The random generator has not been defined." << endl;
-        EXIT
+        if ( neighsModified )
+            m_seModifiedSites.insert( neigh );
     }
+}
 
-    //----- This is adsoprtion ------------------------------------------------------------->
-    s->increaseHeight( 1 );
-    mf_calculateNeighbors( s );
-    m_seAffectedSites.insert( s ) ;
+void Diffusion::mf_performCVDALD( Site* s, Site* neigh ){
+    m_iWrites = OCCUPANCY | LABEL;
 
-    for ( Site* neigh:s->getNeighs() ) {
-        mf_calculateNeighbors( neigh );
-        m_seAffectedSites.insert( neigh ) ;
-    }
-    //--------------------------------------------------------------------------------------<
+    neigh->setOccupied( true );
+    neigh->setBelowSpecies( neigh->getSpecies() );
+    m_pLattice->changeSpecies( neigh, s->getSpecies() );
+
+    s->setOccupied( false );
+    m_pLattice->changeSpecies( s, s->getBelowSpecies() );
+
+    mf_affect( s, false );
+    mf_affect( neigh, false );
 }
 
-void Diffusion::perform( Site* s)
-{
-    (this->*m_fPerform)(s);
+void Diffusion::mf_performCoarse( Site* s, Site* neigh ){
+    m_iWrites = OCCUPANCY | LABEL;
+
+    m_pCoarse->changeCount( s, m_iDiffused, -1 );
+    m_pCoarse->changeCount( neigh, m_iDiffused, 1 );
+
+    mf_affect( s, false );
+    mf_affect( neigh, false );
 }
 
-int Diffusion::mf_calculateNeighbors(Site* s)
-{
-    int neighs = 0;
-
-    if ( m_pLattice->hasSteps() ){
-        for ( Site* neigh:s->getNeighs() ) {
-            if ( s->isLowerStep() && neigh->isHigherStep() ){
-                if ( neigh->getHeight() >= s->getHeight() + m_pLattice->getStepDiff() + 1 )
-                    neighs++;
-            }
-            else if ( neigh->isLowerStep() && s->isHigherStep() ){
-                if ( neigh->getHeight() >= s->getHeight() - m_pLattice->getStepDiff() + 1 )
-                    neighs++;
-            }
-            else {
-                if ( neigh->getHeight() >= s->getHeight() )
-                    neighs++;
-            }
-        }
+void Diffusion::mf_performPVD( Site* s, Site* neigh ){
+    //The top atom of the site is removed and added on the neighbour.
+    //Only the coordination numbers of the two sites and their neighbours change.
+    m_iWrites = HEIGHT | NEIGHBOURS;
 
-        s->setNeighsNum( neighs );
-    }
-    else {
-        for ( Site* neigh:s->getNeighs() ) {
-            if ( neigh->getHeight() >= s->getHeight() )
-                neighs++;
-        }
+    m_pLattice->changeHeight( s, -1 );
+    m_pLattice->changeHeight( neigh, 1 );
 
-        s->setNeighsNum( neighs );
-    }
+    mf_affect( s, true );
+    mf_affect( neigh, true );
+}
+
+void Diffusion::performPair( Site* s, Site* neigh )
+{
+    m_seAffectedSites.clear();
+    m_seModifiedSites.clear();
+    m_iWrites = NONE;
+    (this->*m_fPerform)(s, neigh);
+}
 
-    return neighs;
+void Diffusion::perform( Site* )
+{
+    //A hop is always performed on a pair (see performPair)
+    m_error->error_simple_msg("A diffusion is performed on a hop from a site to its neighbour | " + m_sProcName );
+    EXIT
 }
 
 bool Diffusion::mf_isInLowerStep(Site* s)
@@ -207,9 +245,51 @@ bool Diffusion::mf_isInHigherStep(Site* s)
 
 bool Diffusion::rules( Site* s)
 {
-    (this->*m_fRules)(s);
+    //The site is in the class if an atom can hop from it
+    for ( Site* neigh:s->getNeighs() )
+        if ( (this->*m_fRules)(s, neigh) )
+            return true;
+
+    return false;
+}
+
+bool Diffusion::pairRules( Site* s, Site* neigh )
+{
+    return (this->*m_fRules)(s, neigh);
 }
 
-double Diffusion::getRateConstant(){ m_dProb; }
+double Diffusion::getRateConstant(){ return m_dProb; }
+
+int Diffusion::getCoordination( Site* s )
+{
+    //A cell of a coarse-grained lattice does not resolve the coordination
+    if ( m_pCoarse )
+        return 0;
+
+    if ( isPartOfGrowth() )
+        return s->getNeighsNum();
+
+    int iCount = 0;
+    for ( Site* s1:s->getNeighs() )
+        if ( s1->isOccupied() )
+            iCount++;
+
+    return iCount;
+}
+
+double Diffusion::getPairRate( Site* s, Site* neigh )
+{
+    if ( !m_pCoarse )
+        return m_dProb;
+
+    //The edge of the cells has as many bonds between the sites of the two cells. A bond hops if its site in the cell
+    //has the diffused species and its site in the neighbour is vacant.
+    double dRate = m_dProb*m_pCoarse->getCellEdge();
+    if ( isPartOfGrowth() )
+        return dRate;
+
+    int q = m_pCoarse->getSitesPerCell();
+    return dRate*m_pCoarse->getCount( s, m_iDiffused )/q*m_pCoarse->getVacant( neigh )/q;
+}
 
 }
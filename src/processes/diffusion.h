@@ -41,9 +41,21 @@ public:
 //    inline void setNeigh(int n ){ m_iNumNeighs = n; }
 
     double getRateConstant() override;
+
+    Process* clone() override { return new Diffusion( *this ); }
     bool rules( Site* ) override;
     void perform( Site* ) override;
 
+    /// A diffusion is performed on the hops i.e. a hop from a site to one of its neighbours is an event.
+    bool pairRules( Site* s, Site* neigh ) override;
+    void performPair( Site* s, Site* neigh ) override;
+
+    /// On a coarse-grained lattice the rate of a hop from a cell to its neighbour is the rate of the hops in the bonds between their sites.
+    double getPairRate( Site* s, Site* neigh ) override;
+
+    /// The coordination of the diffused atom in the site: its neighbours in PVD or the occupied neighbours in CVD/ALD.
+    int getCoordination( Site* s ) override;
+
     void init(vector<string> params) override;
 
     void arrhenius(double v0, double E, double Em, double T,  int n);
@@ -60,22 +72,37 @@ private:
     bool mf_isInHigherStep( Site* s );
 
     /// Pointers to functions in order to switch between different functions
-    bool (Diffusion::*m_fRules)(Site*);
-    void (Diffusion::*m_fPerform)(Site*);
+    bool (Diffusion::*m_fRules)(Site*, Site*);
+    void (Diffusion::*m_fPerform)(Site*, Site*);
 
     bool isPartOfGrowth();
 
-    /// If the keyword 'all' is used then the rule is based on the neighbours
-    bool mf_allRule(Site* s);
+    /// If the keyword 'all' is used then the hops are those from the sites with the given number of neighbours (see mf_basicRule)
+    bool mf_allRule(Site* s, Site* neigh);
+
+    /// An atom can hop from every site with a deposited atom to every neighbour
+    bool mf_basicRule(Site* s, Site* neigh);
+
+    /// The diffused species hops to a vacant neighbour at the same height
+    bool mf_speciesRule(Site* s, Site* neigh);
 
-    /// Returns always true - this is actually as having uncoditional acceptance
-    bool mf_basicRule(Site* s);
+    /// As mf_speciesRule for the sites with the given number of occupied neighbours (with the keyword 'all')
+    bool mf_allSpeciesRule(Site* s, Site* neigh);
 
-    /// The process is PVD
-    void mf_performPVD(Site*);
+    /// For a coarse-grained lattice the cell must have the diffused species and its neighbour vacant sites
+    bool mf_coarseRule(Site* s, Site* neigh);
 
-    /// The process is CVD or ALD
-    void mf_performCVDALD(Site*);
+    /// The process is CVD or ALD on a coarse-grained lattice: the diffused species moves from the cell on a vacant site of its neighbour
+    void mf_performCoarse(Site* s, Site* neigh);
+
+    /// The process is PVD: the top atom of the site moves on the neighbour
+    void mf_performPVD(Site* s, Site* neigh);
+
+    /// The process is CVD or ALD: the diffused species moves on the neighbour
+    void mf_performCVDALD(Site* s, Site* neigh);
+
+    /// Stores the site in the affected and the modified sites together with its neighbours (modified too if their coordination changed)
+    void mf_affect( Site* s, bool neighsModified );
 
     ///The site to for the adsorption to be removed
     Site* m_originSite;
@@ -83,15 +110,18 @@ private:
     ///The site that adsorption will be performed
     Site* m_targetSite;
 
-    /// A member function to calculate the neighbors of a given site
-    int mf_calculateNeighbors(Site*);
-
     /// The number of neighbours for calculating the probability
     int m_iNumNeighs;
 
     /// The label of the diffused species
     string m_sDiffused;
 
+    /// The height of the substrate in each site by its ID (for PVD)
+    vector<int> m_vSubstrate;
+
+    /// The ID of the diffused surface species (for CVD/ALD)
+    int m_iDiffused;
+
     /// If the user has "all" keyword this is set to true
     bool m_bAllNeihs;
 
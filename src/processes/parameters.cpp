@@ -20,13 +20,22 @@
 namespace Utils  
 {
 
-  Parameters::Parameters(Apothesis* apothesis ):Pointers(apothesis), m_iRand(0){}
+  Parameters::Parameters(Apothesis* apothesis ):Pointers(apothesis), m_iRand(0), m_sSelection("linear"), m_sScheduler("direct"), m_iParallelDomains(0), m_dParallelWindow(0.0), m_iEnsembleRuns(0), m_iThreads(0), m_bCheckpoint(false), m_dCheckpointTime(0.0), m_dCheckpointWallTime(0.0), m_iAccelerationStage(0), m_dAccelerationTolerance(0.0), m_dAccelerationFast(0.0), m_iAccelerationMinimum(0){}
   
   void Parameters::setProcess( string processName, vector< string > processParams )
   {
     m_mProcs[ processName ] = processParams;
   }
 
+  void Parameters::setCoverageSpecies( vector<string> species )
+  {
+    m_vCovSpecies = species;
+
+    m_viCovSpecies.clear();
+    for ( string s:species )
+        m_viCovSpecies.push_back( m_Species.add( s ) );
+  }
+
   void Parameters::printInfo()
   {
       cout << endl;
@@ -38,6 +47,16 @@ namespace Utils
       cout << "Random gen init " << m_iRand << endl;
       cout << "Write in log every " << m_dWriteLogEvery << endl;
       cout << "Write lattice every " << m_dWriteLatticeEvery << endl;
+      cout << "Species " << m_Species.size() - 1 << endl;
+      cout << "Selection " << m_sSelection << endl;
+      cout << "Scheduler " << m_sScheduler << endl;
+      cout << "Parallel domains " << m_iParallelDomains << " window " << m_dParallelWindow << endl;
+      cout << "Ensemble runs " << m_iEnsembleRuns << endl;
+      cout << "Sweep parameters " << m_vSweeps.size() << endl;
+      cout << "Threads " << m_iThreads << endl;
+      cout << "Checkpoint every " << m_dCheckpointTime << " sec wall time " << m_dCheckpointWallTime << " sec" << endl;
+      cout << "Restart from " << m_sRestartFile << endl;
+      cout << "Acceleration stage " << m_iAccelerationStage << " events tolerance " << m_dAccelerationTolerance << " fast ratio " << m_dAccelerationFast << " minimum " << m_iAccelerationMinimum << endl;
       cout << "---------------------------------------- " << endl;
       cout << "--- end simulation parameters info ----- " << endl;
       cout << endl;
@@ -21,6 +21,7 @@
 #include "pointers.h"
 #include "apothesis.h"
 #include "site.h"
+#include "species_registry.h"
 #include <iostream>
 #include <any>
 
@@ -29,6 +30,19 @@ using namespace SurfaceTiles;
 
 namespace Utils {
 
+/** A parameter that takes a list of values in a sweep */
+struct SweptParameter
+{
+    /// temperature, pressure or the name of a process
+    string sName;
+
+    /// The position of the parameter of the process (0 for temperature and pressure)
+    int iPosition;
+
+    /// The values as given in the input file
+    vector<string> vsValues;
+};
+
 /** A class which hold all the parameters needed by KMC.
  * Other parameters needed by the individual processes can be defined there. */
 
@@ -100,23 +114,120 @@ class Parameters: public Pointers
     void printInfo();
 
     /// The label for the species in the lattice
-    inline void setLatticeLabels( string label ){ m_sLatticeLabel = label; }
+    inline void setLatticeLabels( string label ){ m_sLatticeLabel = label; m_Species.add( label ); }
 
     /// The label for the species in the lattice
     inline string getLatticeLabels(){ return m_sLatticeLabel; }
 
     /// Instert a species that participates in the growth of the film
-    inline void insertInGrowthSpecies( string s ){ m_vsGrowthSpecies.push_back( s ); }
+    inline void insertInGrowthSpecies( string s ){ m_vsGrowthSpecies.push_back( s ); m_Species.add( s ); }
 
     /// Returns the species that participates in the growth of the film
     inline vector<string> getGrowthSpecies(){ return m_vsGrowthSpecies; }
 
     /// The species to compute coverage for
-    inline void setCoverageSpecies( vector<string> species ){ m_vCovSpecies = species; }
+    void setCoverageSpecies( vector<string> species );
 
     /// Returns the species for which to compute coverage for
     inline vector<string> getCoverageSpecies(){ return m_vCovSpecies; }
 
+    /// Returns the registry of the species (their IDs are assigned when the input file is read)
+    inline SpeciesRegistry& getSpeciesRegistry(){ return m_Species; }
+
+    /// Returns the IDs of the species to compute coverage for (in the order they are given)
+    inline const vector<int>& getCoverageSpeciesIDs(){ return m_viCovSpecies; }
+
+    /// Set the method for selecting the process class of the next event (linear or tree)
+    inline void setSelection( string selection ){ m_sSelection = selection; }
+
+    /// Returns the method for selecting the process class of the next event
+    inline string getSelection(){ return m_sSelection; }
+
+    /// Set the method for advancing the simulation (direct or nrm)
+    inline void setScheduler( string scheduler ){ m_sScheduler = scheduler; }
+
+    /// Returns the method for advancing the simulation
+    inline string getScheduler(){ return m_sScheduler; }
+
+    /// Set the number of domains for the parallel (synchronous sublattice) run (0 for a serial run)
+    inline void setParallelDomains( int domains ){ m_iParallelDomains = domains; }
+
+    /// Returns the number of domains for the parallel run
+    inline int getParallelDomains(){ return m_iParallelDomains; }
+
+    /// Set the time window of a cycle of the parallel run [s]
+    inline void setParallelWindow( double window ){ m_dParallelWindow = window; }
+
+    /// Returns the time window of a cycle of the parallel run
+    inline double getParallelWindow(){ return m_dParallelWindow; }
+
+    /// Set the number of runs of the ensemble (0 for a single run)
+    inline void setEnsembleRuns( int runs ){ m_iEnsembleRuns = runs; }
+
+    /// Returns the number of runs of the ensemble
+    inline int getEnsembleRuns(){ return m_iEnsembleRuns; }
+
+    /// Set the number of threads performing the runs of an ensemble or a sweep (0 for the number of cores)
+    inline void setThreads( int threads ){ m_iThreads = threads; }
+
+    /// Returns the number of threads performing the runs of an ensemble or a sweep
+    inline int getThreads(){ return m_iThreads; }
+
+    /// Adds a swept parameter i.e. temperature, pressure or the parameter of a process in the given position
+    /// (1 for the first parameter after the type of the process) with the values that it takes in the sweep.
+    inline void addSweep( string name, int position, vector<string> values ){ m_vSweeps.push_back( { name, position, values } ); }
+
+    /// Returns the swept parameters
+    inline const vector<SweptParameter>& getSweeps(){ return m_vSweeps; }
+
+    /// Enables the checkpoints (they are written when a signal is received and at the intervals below)
+    inline void setCheckpoint( bool checkpoint ){ m_bCheckpoint = checkpoint; }
+
+    /// Returns true if the checkpoints are enabled
+    inline bool getCheckpoint(){ return m_bCheckpoint; }
+
+    /// Set the interval of simulated time between checkpoints [s] (0 for none)
+    inline void setCheckpointTime( double time ){ m_dCheckpointTime = time; }
+
+    /// Returns the interval of simulated time between checkpoints
+    inline double getCheckpointTime(){ return m_dCheckpointTime; }
+
+    /// Set the interval of wall clock time between checkpoints [s] (0 for none)
+    inline void setCheckpointWallTime( double time ){ m_dCheckpointWallTime = time; }
+
+    /// Returns the interval of wall clock time between checkpoints
+    inline double getCheckpointWallTime(){ return m_dCheckpointWallTime; }
+
+    /// Set the events of a stage of the acceleration of the quasi-equilibrated fast processes (0 for no acceleration)
+    inline void setAccelerationStage( int events ){ m_iAccelerationStage = events; }
+
+    /// Returns the events of a stage of the acceleration
+    inline int getAccelerationStage(){ return m_iAccelerationStage; }
+
+    /// Set the tolerance of the quasi-equilibrium of a pair of fast processes
+    inline void setAccelerationTolerance( double tolerance ){ m_dAccelerationTolerance = tolerance; }
+
+    /// Returns the tolerance of the quasi-equilibrium
+    inline double getAccelerationTolerance(){ return m_dAccelerationTolerance; }
+
+    /// Set the ratio of the executions of a quasi-equilibrated pair to those of the slow processes that the acceleration keeps
+    inline void setAccelerationFast( double fast ){ m_dAccelerationFast = fast; }
+
+    /// Returns the ratio of the executions of a quasi-equilibrated pair to those of the slow processes
+    inline double getAccelerationFast(){ return m_dAccelerationFast; }
+
+    /// Set the executions of a stage for a pair to be tested for the quasi-equilibrium (0 to derive it from the tolerance)
+    inline void setAccelerationMinimum( long executions ){ m_iAccelerationMinimum = executions; }
+
+    /// Returns the executions of a stage for a pair to be tested for the quasi-equilibrium
+    inline long getAccelerationMinimum(){ return m_iAccelerationMinimum; }
+
+    /// Set the checkpoint that the run is restarted from (empty for a new run)
+    inline void setRestartFile( string file ){ m_sRestartFile = file; }
+
+    /// Returns the checkpoint that the run is restarted from
+    inline string getRestartFile(){ return m_sRestartFile; }
+
   protected:
     /// The temperature [K].
     double m_dT;
@@ -151,6 +262,57 @@ class Parameters: public Pointers
     /// The species to compute coverage for
     vector<string> m_vCovSpecies;
 
+    /// The IDs of the species to compute coverage for
+    vector<int> m_viCovSpecies;
+
+    /// The registry of the species
+    SpeciesRegistry m_Species;
+
+    /// The method for selecting the process class of the next event
+    string m_sSelection;
+
+    /// The method for advancing the simulation
+    string m_sScheduler;
+
+    /// The number of domains of the parallel run (0 for a serial run)
+    int m_iParallelDomains;
+
+    /// The time window of a cycle of the parallel run [s]
+    double m_dParallelWindow;
+
+    /// The number of runs of the ensemble (0 for a single run)
+    int m_iEnsembleRuns;
+
+    /// The number of threads performing the runs of an ensemble or a sweep (0 for the number of cores)
+    int m_iThreads;
+
+    /// The swept parameters
+    vector<SweptParameter> m_vSweeps;
+
+    /// True if the checkpoints are enabled
+    bool m_bCheckpoint;
+
+    /// The interval of simulated time between checkpoints [s] (0 for none)
+    double m_dCheckpointTime;
+
+    /// The interval of wall clock time between checkpoints [s] (0 for none)
+    double m_dCheckpointWallTime;
+
+    /// The checkpoint that the run is restarted from (empty for a new run)
+    string m_sRestartFile;
+
+    /// The events of a stage of the acceleration (0 for no acceleration)
+    int m_iAccelerationStage;
+
+    /// The tolerance of the quasi-equilibrium of the acceleration
+    double m_dAccelerationTolerance;
+
+    /// The ratio of the executions of a quasi-equilibrated pair to those of the slow processes
+    double m_dAccelerationFast;
+
+    /// The executions of a stage for a pair to be tested for the quasi-equilibrium (0 to derive it from the tolerance)
+    long m_iAccelerationMinimum;
+
   };
 
 }
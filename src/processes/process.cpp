@@ -16,10 +16,17 @@
 //============================================================================
 
 #include "process.h"
+#include "CoarseGrained.h"
 
-Process::Process():m_iHappened(0),m_bUncoAccept(false), m_iNumSites(1),  m_iNumNeighs(1), m_iNumVacant(1) {}
+Process::Process():m_pCoarse(0),m_iHappened(0),m_bUncoAccept(false), m_iNumSites(1),  m_iNumNeighs(1), m_iNumVacant(1), m_iWrites(ALL), m_iReads(ALL), m_iRadius(1), m_bPair(false) {}
 Process::~Process(){}
 
+void Process::setLattice( Lattice* lattice )
+{
+    m_pLattice = lattice;
+    m_pCoarse = lattice->getType() == Lattice::CoarseGrained ? static_cast<CoarseGrained*>( lattice ) : 0;
+}
+
 bool Process::isPartOfGrowth( string name){
     for ( string species: m_pUtilParams->getGrowthSpecies() ){
         if ( species.compare( name ) == 0 )
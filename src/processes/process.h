@@ -34,6 +34,8 @@ using namespace std;
 using namespace SurfaceTiles;
 using namespace Utils;
 
+class CoarseGrained;
+
 /** The pure virtual class from which every other process is generated.*/
 namespace MicroProcesses
 {
@@ -42,24 +44,65 @@ class Process
 {
 
 public:
+    /// The attributes of a site that the rules of a process read and its performs write.
+    /// They are combined as flags and the engine re-tests a process in a site only if the last perform wrote something that its rules read.
+    enum Attribute{ NONE = 0, HEIGHT = 1, OCCUPANCY = 2, LABEL = 4, NEIGHBOURS = 8, ALL = 15 };
+
     Process();
     virtual ~Process();
 
     ///Get probability
     virtual double getRateConstant() = 0;
 
+    /// Returns the rate of this process in the given site. By default it is the rate constant i.e. the same in every site.
+    /// Processes with site dependent rates override it. The rate must depend only on the attributes that the rules read
+    /// as it is recomputed when the rules are re-tested. Only the next reaction method uses it.
+    virtual double getRate( Site* ){ return getRateConstant(); }
+
     /// Perform this process in the site and compute/store the affected sites
     virtual void perform( Site* ) = 0;
 
     /// The rules for this type of process e.g. the neighbour of site Site.
     virtual bool rules( Site* ) = 0;
 
+    /// Pair processes (e.g. A* + B* -> AB*) are performed on a bond i.e. a site and one of its neighbours, so that their rate is
+    /// per reactive pair. Their events are the bonds where pairRules() holds instead of the sites where rules() holds.
+    inline bool isPairProcess(){ return m_bPair; }
+
+    /// The rules of a pair process for the bond from the site to its neighbour. Every pair must hold in one orientation only.
+    virtual bool pairRules( Site*, Site* ){ return false; }
+
+    /// Perform this pair process in the site and its neighbour and compute/store the affected sites (as perform).
+    virtual void performPair( Site*, Site* ){}
+
+    /// Returns the rate of this pair process in the bond from the site to its neighbour (as getRate for the sites).
+    virtual double getPairRate( Site*, Site* ){ return getRateConstant(); }
+
+    /// Returns the coordination of what this process moves when it is in the site (e.g. the atom that a diffusion hops).
+    /// The acceleration compares the hops that raise it with those that lower it (see Engine::RateScaling).
+    virtual int getCoordination( Site* ){ return 0; }
+
+    /// Returns a copy of this process with the same parameters, rules and performs (e.g. for every thread to have its own processes).
+    virtual Process* clone() = 0;
+
     /// Initialization for this process (e.g. temperature, pressure, mole fraction etc.)
     /// This must be for every process according to the process
     virtual void init( vector<string> params ){ m_vParams = params; }
 
-    /// Returns the sites that are affected by this process including the site that this process is performed.
-    inline set<Site*> getAffectedSites() { return m_seAffectedSites; }
+    /// Returns the sites that are affected by the last perform of this process including the site that this process is performed.
+    inline const set<Site*>& getAffectedSites() { return m_seAffectedSites; }
+
+    /// Returns the sites whose attributes were written by the last perform of this process (a subset of the affected sites).
+    inline const set<Site*>& getModifiedSites() { return m_seModifiedSites; }
+
+    /// Returns the attributes written by the last perform of this process.
+    inline int getWrites(){ return m_iWrites; }
+
+    /// Returns the attributes that the rules of this process read.
+    inline int getReads(){ return m_iReads; }
+
+    /// Returns how far from a site the rules of this process read: 0 only the site itself, 1 the site and its neighbours.
+    inline int getRadius(){ return m_iRadius; }
 
     inline void setName( string procName ){ m_sProcName = procName; }
     inline string getName(){ return  m_sProcName; }
@@ -67,13 +110,17 @@ public:
     inline void setID( int id ){ m_iID = id; }
     inline int getID(){ return m_iID; }
 
-    inline void setLattice( Lattice* lattice ){ m_pLattice = lattice; }
+    /// Sets the lattice of the process (and the coarse-grained lattice if it is one).
+    void setLattice( Lattice* lattice );
 
     /// Counts how many times this process happens
     inline void eventHappened(){ m_iHappened++; }
 
     /// Returns how many times this process happened
-    int getNumEventHappened(){ return m_iHappened; }
+    long getNumEventHappened(){ return m_iHappened; }
+
+    /// Sets how many times this process happened (e.g. when a run is restarted)
+    inline void setNumEventHappened( long happened ){ m_iHappened = happened; }
 
     /// Set the random generator
     inline void setRandomGen( RandomGen::RandomGenerator* randgen ) { m_pRandomGen = randgen; }
@@ -96,6 +143,10 @@ protected:
     ///Pointer to the lattice of the process
     Lattice* m_pLattice;
 
+    /// The lattice of the process if it is coarse-grained (null otherwise). Its sites are cells and the processes
+    /// read and write the numbers of the species in the cells instead of the species of the sites.
+    CoarseGrained* m_pCoarse;
+
     ///The parameters of the system and constant values
     Utils::Parameters* m_pUtilParams;
 
@@ -107,9 +158,24 @@ protected:
     /// followed by the parameters needed for this process to perform
     vector<string> m_vParams;
 
-    ///A list holding all affected sites from this process
+    ///A list holding all affected sites from the last perform of this process (cleared at the beginning of each perform)
     set<Site*> m_seAffectedSites;
 
+    ///A list holding the sites whose attributes were written by the last perform of this process (cleared at the beginning of each perform)
+    set<Site*> m_seModifiedSites;
+
+    /// The attributes written by the last perform (cleared at the beginning of each perform)
+    int m_iWrites;
+
+    /// The attributes that the rules of this process read (default all, i.e. always re-tested)
+    int m_iReads;
+
+    /// How far from a site the rules of this process read (default 1)
+    int m_iRadius;
+
+    /// True if this is a pair process (default false)
+    bool m_bPair;
+
     ///The random generator
     RandomGen::RandomGenerator* m_pRandomGen;
 
@@ -142,7 +208,7 @@ private:
     int m_iID;
 
     /// Counts the times that this processes happened
-    int m_iHappened;
+    long m_iHappened;
 };
 }
 
@@ -16,6 +16,10 @@
 //============================================================================
 
 #include "reaction.h"
+#include "CoarseGrained.h"
+
+#include <cmath>
+#include <numeric>
 
 Reaction::Reaction(): m_bLeadsToGrowth(false){}
 Reaction::~Reaction(){}
@@ -61,29 +65,60 @@ void Reaction::init(vector<string> params){
         }
     }
 
-    if ( !m_bLeadsToGrowth ) {
+    //A reaction of two reactants is performed on the pairs of neighbouring reactants so its rate is per pair.
+    //The bond of a pair reads the species of its two sites (and their heights if the reaction leads to growth).
+    if ( allReactCoeffOne() && m_vReactants.size() == 2 && ( !m_bLeadsToGrowth || m_vProducts.size() <= 2 ) ){
+        m_bPair = true;
+        m_fRules = &Reaction::simpleRule;
+        m_iReads = m_bLeadsToGrowth ? OCCUPANCY | LABEL | HEIGHT : OCCUPANCY | LABEL;
+        m_iRadius = 1;
+    }
+    else if ( !m_bLeadsToGrowth ) {
         m_fRules = &Reaction::simpleRule;
         m_fPerform = &Reaction::catalysis;
+        m_iReads = OCCUPANCY | LABEL;
+        m_iRadius = 1;
     }
-    else {
-        if ( allReactCoeffOne() && m_vReactants.size() == 2 && m_vProducts.size() <= 2  ){
-            m_fRules = &Reaction::oneOneRule;
-            m_fPerform = &Reaction::oneOneReaction;
-        }
+
+    //On a coarse-grained lattice the reactants react in the cells (see coarseEvents)
+    if ( m_pCoarse ){
+        m_bPair = false;
+        m_fRules = &Reaction::coarseRule;
+        m_fPerform = &Reaction::coarseReaction;
+        m_iReads = OCCUPANCY | LABEL;
+        m_iRadius = 0;
+
+        for ( string r:m_vReactants )
+            m_vCoarseReactants.push_back( m_pUtilParams->getSpeciesRegistry().add( r ) );
     }
 }
 
 void Reaction::buildTransformationMatrix(){
-    int iCount = 0;
-    for (string r:m_vReactants ) {
-        if ( iCount < m_vProducts.size() ) {
-            m_mTransformationMatrix[ r ] = m_vProducts[ iCount ];
+    SpeciesRegistry& species = m_pUtilParams->getSpeciesRegistry();
+
+    //The species are registered when the input is read so this only finds their IDs
+    vector<int> reactants, products;
+    for ( string r:m_vReactants )
+        reactants.push_back( species.add( r ) );
+    for ( string p:m_vProducts )
+        products.push_back( species.add( p ) );
+
+    m_vTransformationMatrix.assign( species.size(), -1 );
+    m_vLeadsToGrowth.assign( species.size(), false );
+    for ( unsigned int iCount = 0; iCount < reactants.size(); iCount++ ) {
+        if ( iCount < products.size() ) {
+            m_vTransformationMatrix[ reactants[ iCount ] ] = products[ iCount ];
+            m_vLeadsToGrowth[ reactants[ iCount ] ] = isPartOfGrowth( m_vProducts[ iCount ] );
+        }
+        else {
+            m_vTransformationMatrix[ reactants[ iCount ] ] = -1;
+            m_vLeadsToGrowth[ reactants[ iCount ] ] = false;
         }
-        else
-            m_mTransformationMatrix[ r ] = "";
-
-        iCount++;
     }
+
+    m_vIsReactant.assign( species.size(), false );
+    for ( pair<string, int> r:m_mReactants )
+        m_vIsReactant[ species.add( r.first ) ] = true;
 }
 
 bool Reaction::allReactCoeffOne(){
@@ -107,94 +142,148 @@ void Reaction::arrheniusType(double v0, double Ed, double T)
 }
 
 bool Reaction::leadsToGrowth(Site* s){
-    vector<string> gSpecies = m_pUtilParams->getGrowthSpecies();
+    return m_vLeadsToGrowth[ s->getSpecies() ];
+}
 
-    if ( m_mTransformationMatrix[ s->getLabel() ] == "")
+bool Reaction::pairRules( Site* s, Site* neigh ){
+    //The pair is taken from the reactant with the smaller species ID so that it is counted once
+    if ( !s->isOccupied() || !neigh->isOccupied() || s->getSpecies() >= neigh->getSpecies() )
         return false;
 
-    for ( string gs:gSpecies ){
-        if ( gs.compare( m_mTransformationMatrix[ s->getLabel() ] ) == 0 ) {
-            return true;
-        }
-    }
+    if ( !isReactant( s ) || !isReactant( neigh ) )
+        return false;
 
-    return false;
+    return !m_bLeadsToGrowth || s->getHeight() == neigh->getHeight();
 }
 
-void Reaction::oneOneReaction( Site* s){
-    vector<Site* > potSites;
-    for ( Site* s1:s->getNeighs() ) {
-        if ( s1->getLabel().compare( s->getLabel() ) != 0 && isReactant(s1) && s1->getHeight() == s->getHeight() )
-            potSites.push_back( s1 );
-    }
+void Reaction::performPair( Site* s, Site* neigh ){
+    m_seAffectedSites.clear();
+    m_seModifiedSites.clear();
+    m_iWrites = OCCUPANCY | LABEL;
 
-    int lucky = m_pRandomGen->getIntRandom(0, potSites.size() - 1 );
+    transform( s );
+    transform( neigh );
+}
 
-    Site* otherSite = potSites[ lucky ];
+void Reaction::transform( Site* s ){
+    s->setOccupied( false );
 
-    if ( !isReactant(s ) || !isReactant(otherSite ) || otherSite->getLabel().compare( s->getLabel() ) == 0 ||
-         otherSite->getHeight() != s->getHeight() ){
-        cout << s->getID() << " " << otherSite->getID() << endl;
-        cout << "Problem with performing reaction." << endl;
-        otherSite->setOccupied( false );
-        otherSite->setLabel( "X" );
+    //Without growth the reactants leave the surface
+    bool bGrows = false;
+    if ( !m_bLeadsToGrowth )
+        m_pLattice->changeSpecies( s, s->getBelowSpecies() );
+    else {
+        bGrows = leadsToGrowth( s );
+        if ( bGrows ){
+            m_pLattice->changeHeight( s, 1 );
+            m_iWrites |= HEIGHT | NEIGHBOURS;
+        }
 
-        std::string name = std::string("SurfaceSpecies") + std::string("ERROR") + std::string(".dat");
-        std::ofstream file(name);
+        if ( m_vTransformationMatrix[ s->getSpecies() ] != -1 )
+            m_pLattice->changeSpecies( s, m_vTransformationMatrix[ s->getSpecies() ] );
+        else
+            m_pLattice->changeSpecies( s, s->getBelowSpecies() );
+    }
 
-        file << "Time (s): " << time << endl;
+    //The coordination numbers of the neighbours change with the height of the site
+    m_seAffectedSites.insert( s );
+    m_seModifiedSites.insert( s );
+    for ( Site* neigh:s->getNeighs() ) {
+        m_seAffectedSites.insert( neigh );
+        if ( bGrows )
+            m_seModifiedSites.insert( neigh );
+    }
+}
 
-        for (int i = 0; i < m_pLattice->getY(); i++){
-            for (int j = 0; j < m_pLattice->getX(); j++)
-                file << m_pLattice->getSite( i*m_pLattice->getX() + j )->getLabel() << " " ;
+bool Reaction::coarseRule( Site* s ){
+    return coarseEvents( s ) > 0.0;
+}
 
-            file << endl;
-        }
-        EXIT;
-    }
+double Reaction::coarsePairs( Site* s, int species, int other ){
+    int q = m_pCoarse->getSitesPerCell();
+    int iCount = m_pCoarse->getCount( s, species );
+    if ( q < 2 || iCount == 0 )
+        return 0.0;
 
+    int iOthers = 0;
+    for ( int r:m_vCoarseReactants )
+        if ( r != species && ( other < 0 || r == other ) )
+            iOthers += m_pCoarse->getCount( s, r );
 
-    if ( leadsToGrowth(s) )
-        s->increaseHeight(1);
+    int z = s->getNeighs().size();
+    double p = (double)iOthers/( q - 1 );
 
-    if ( leadsToGrowth(otherSite) )
-        otherSite->increaseHeight(1);
+    //The pairs of the two reactants are counted once; otherwise the sites of the species with a neighbour of another reactant
+    if ( other >= 0 )
+        return iCount*z*p;
 
-    s->setOccupied(false);
-    if ( m_mTransformationMatrix[ s->getLabel() ] != "" )
-        s->setLabel( m_mTransformationMatrix[s->getLabel() ] );
-    else
-        s->setLabel( s->getBelowLabel() );
+    return iCount*( 1.0 - pow( 1.0 - p, z ) );
+}
 
-    m_seAffectedSites.insert( s );
-    for ( Site* neigh:s->getNeighs() )
-        m_seAffectedSites.insert( neigh );
+double Reaction::coarseEvents( Site* s ){
+    //Every other site of the cell has each species with the same probability.
+    //The reaction of two reactants happens in the pairs of neighbouring reactants as on the lattice of sites.
+    if ( allReactCoeffOne() && m_vCoarseReactants.size() == 2 && m_vCoarseReactants[ 0 ] != m_vCoarseReactants[ 1 ] )
+        return coarsePairs( s, m_vCoarseReactants[ 0 ], m_vCoarseReactants[ 1 ] );
 
-    otherSite->setOccupied( false );
-    if ( m_mTransformationMatrix[ otherSite->getLabel() ] != "" )
-        otherSite->setLabel( m_mTransformationMatrix[ otherSite->getLabel() ] );
-    else
-        otherSite->setLabel( otherSite->getBelowLabel() );
+    double dEvents = 0.0;
+    for ( int r:m_vCoarseReactants )
+        dEvents += coarsePairs( s, r, -1 );
 
-    m_seAffectedSites.insert( otherSite );
-    for ( Site* neigh:otherSite->getNeighs() )
-        m_seAffectedSites.insert( neigh );
+    return dEvents;
 }
 
-bool Reaction::oneOneRule(Site* s){
-    if ( !s->isOccupied() ) return false;
+void Reaction::coarseReaction( Site* s ){
+    m_iWrites = OCCUPANCY | LABEL;
+
+    //The pair that reacts is picked by its share of the events
+    int iSpecies = m_vCoarseReactants[ 0 ], iOther = m_vCoarseReactants.size() > 1 ? m_vCoarseReactants[ 1 ] : -1;
+    if ( !allReactCoeffOne() || m_vCoarseReactants.size() != 2 || iSpecies == iOther ){
+        vector<double> vEvents;
+        for ( int r:m_vCoarseReactants )
+            vEvents.push_back( coarsePairs( s, r, -1 ) );
+
+        double dRandom = m_pRandomGen->getDoubleRandom()*accumulate( vEvents.begin(), vEvents.end(), 0.0 );
+        unsigned int i = 0;
+        while ( i < vEvents.size() - 1 && ( dRandom -= vEvents[ i ] ) >= 0.0 )
+            i++;
+        iSpecies = m_vCoarseReactants[ i ];
+
+        vector<int> vOthers;
+        for ( int r:m_vCoarseReactants )
+            if ( r != iSpecies )
+                vOthers.push_back( m_pCoarse->getCount( s, r ) );
+
+        int iRandom = m_pRandomGen->getIntRandom( 0, accumulate( vOthers.begin(), vOthers.end(), 0 ) - 1 );
+        for ( int r:m_vCoarseReactants ){
+            if ( r == iSpecies )
+                continue;
+
+            iOther = r;
+            if ( ( iRandom -= m_pCoarse->getCount( s, r ) ) < 0 )
+                break;
+        }
+    }
 
-    if ( !isReactant( s ) ) return false;
-    else {
-        //Search for the other sites
-        for ( Site* s1:s->getNeighs() ) {
-            if ( s1->getLabel().compare( s->getLabel() ) != 0 && isReactant( s1 ) && s->getHeight() == s1->getHeight() )
-                return true;
+    //The reactants leave the surface or the ones that lead to growth grow the film
+    for ( int r:{ iSpecies, iOther } ){
+        m_pCoarse->changeCount( s, r, -1 );
+
+        if ( m_bLeadsToGrowth && m_vLeadsToGrowth[ r ] ){
+            m_pLattice->changeHeight( s, 1 );
+            m_iWrites |= HEIGHT | NEIGHBOURS;
         }
     }
-    return false;
-}
 
+    //The hops to the cell start from its neighbours and a new layer changes their coordination
+    m_seAffectedSites.insert( s );
+    m_seModifiedSites.insert( s );
+    for ( Site* neigh:s->getNeighs() ) {
+        m_seAffectedSites.insert( neigh );
+        if ( m_iWrites & HEIGHT )
+            m_seModifiedSites.insert( neigh );
+    }
+}
 
 bool Reaction::simpleRule(Site* s){
     if ( !s->isOccupied() ) return false;
@@ -203,7 +292,7 @@ bool Reaction::simpleRule(Site* s){
     else {
         //Search for the other sites
         for ( Site* s1:s->getNeighs() ) {
-            if ( s1->getLabel().compare( s->getLabel() ) != 0 && isReactant( s1 ) )
+            if ( s1->getSpecies() != s->getSpecies() && isReactant( s1 ) )
                 return true;
         }
     }
@@ -212,19 +301,19 @@ bool Reaction::simpleRule(Site* s){
 
 bool Reaction::rules(Site *s)
 {
-    (this->*m_fRules)(s);
+    return (this->*m_fRules)(s);
 }
 
 bool Reaction::isReactant(Site* s){
-
-    auto it = m_mReactants.find( s->getLabel() );
-    if ( it != m_mReactants.end() )
-        return true;
-    return false;
+    unsigned int species = s->getSpecies();
+    return species < m_vIsReactant.size() && m_vIsReactant[ species ];
 }
 
 void Reaction::perform(Site *s)
 {
+    m_seAffectedSites.clear();
+    m_seModifiedSites.clear();
+    m_iWrites = NONE;
     (this->*m_fPerform)(s);
 }
 
@@ -232,14 +321,14 @@ void Reaction::catalysis(Site *s){
 
     vector<Site* > potSites;
     for ( Site* s1:s->getNeighs() ) {
-        if ( s1->getLabel().compare( s->getLabel() ) != 0 && isReactant(s1) )
+        if ( s1->getSpecies() != s->getSpecies() && isReactant(s1) )
             potSites.push_back( s1 );
     }
 
     int lucky = m_pRandomGen->getIntRandom(0, potSites.size() - 1 );
     Site* otherSite = potSites[ lucky ];
 
-    if ( !isReactant(otherSite ) || otherSite->getLabel().compare( s->getLabel() ) == 0){
+    if ( !isReactant(otherSite ) || otherSite->getSpecies() == s->getSpecies()){
 
         cout << s->getID() << " " << otherSite->getID() << endl;
 
@@ -255,7 +344,7 @@ void Reaction::catalysis(Site *s){
 
         for (int i = 0; i < m_pLattice->getY(); i++){
             for (int j = 0; j < m_pLattice->getX(); j++)
-                file << m_pLattice->getSite( i*m_pLattice->getX() + j )->getLabel() << " " ;
+                file << m_pLattice->getSite( i, j )->getLabel() << " " ;
 
             file << endl;
         }
@@ -263,18 +352,24 @@ void Reaction::catalysis(Site *s){
         EXIT;
     }
 
+    m_iWrites = OCCUPANCY | LABEL;
+
     s->setOccupied(false);
-    s->setLabel( s->getBelowLabel() );
+    m_pLattice->changeSpecies( s, s->getBelowSpecies() );
     m_seAffectedSites.insert( s );
+    m_seModifiedSites.insert( s );
     for ( Site* neigh:s->getNeighs() )
         m_seAffectedSites.insert( neigh );
 
     otherSite->setOccupied( false );
-    otherSite->setLabel( otherSite->getBelowLabel() );
+    m_pLattice->changeSpecies( otherSite, otherSite->getBelowSpecies() );
     m_seAffectedSites.insert( otherSite );
+    m_seModifiedSites.insert( otherSite );
     for ( Site* neigh:otherSite->getNeighs() )
         m_seAffectedSites.insert( neigh );
 }
 
 double Reaction::getRateConstant(){ return m_dProb; }
 
+double Reaction::getRate( Site* s ){ return m_pCoarse ? m_dProb*coarseEvents( s ) : m_dProb; }
+
@@ -37,7 +37,14 @@ public:
 
     void perform(Site *) override;
     bool rules(Site *) override;
+    bool pairRules( Site* s, Site* neigh ) override;
+    void performPair( Site* s, Site* neigh ) override;
     double getRateConstant() override;
+
+    /// On a coarse-grained lattice the rate of a cell is the rate constant times the number of the events expected in it.
+    double getRate( Site* s ) override;
+
+    Process* clone() override { return new Reaction( *this ); }
     void init(vector<string> params) override;
 
     inline void setReactants( unordered_map<string, int> reactants ) {m_mReactants = reactants;}
@@ -70,12 +77,28 @@ private:
     /// Reactions without growth taken into account
     void catalysis(Site* s);
 
-    /// 1-1 Reaction, e.g. A* + B* -> AB*
-    void oneOneReaction(Site* s);
-    bool oneOneRule(Site* s);
+    /// Transforms a site of a pair to its product (the species below it if it has none) and stores it in the affected sites.
+    void transform( Site* s );
 
     bool simpleRule(Site* s);
 
+    /// For a coarse-grained lattice the cell must have reactants that can react.
+    bool coarseRule( Site* s );
+
+    /// Returns the expected number of the events in the cell: the pairs of neighbouring reactants for a reaction of two reactants,
+    /// otherwise the sites of a reactant with a neighbour of another reactant (as the rules of the lattice of sites).
+    double coarseEvents( Site* s );
+
+    /// Returns the expected number of the sites of the species in the cell with a neighbour of another reactant
+    /// or (if the other species is given) the expected number of the pairs of neighbouring sites of the two species.
+    double coarsePairs( Site* s, int species, int other );
+
+    /// The reaction on a coarse-grained lattice: a pair of reactants of the cell reacts
+    void coarseReaction( Site* s );
+
+    /// The IDs of the reactants in the order they are given (for a coarse-grained lattice)
+    vector<int> m_vCoarseReactants;
+
     /// The reactants participating in this reaction
     unordered_map<string, int> m_mReactants;
 
@@ -94,7 +117,14 @@ private:
     bool allReactCoeffOne();
 
     /// Holds the species what to be tranformed according to the reaction e.g. A + B -> C + D, then A will be replaced by C and b by D and so on and so forth.
-    unordered_map<string, string> m_mTransformationMatrix;
+    /// It is indexed by the ID of the species and holds the ID of the species it is transformed to (-1 if the site returns to the species below it).
+    vector<int> m_vTransformationMatrix;
+
+    /// True for the species (by their ID) that are transformed to a species of the growing film
+    vector<bool> m_vLeadsToGrowth;
+
+    /// True for the species (by their ID) that are reactants
+    vector<bool> m_vIsReactant;
 
     /// Constructs the transformation matrix.
     void buildTransformationMatrix();
@@ -9,6 +9,14 @@ Properties::Properties(Apothesis* apothesis ):
 
 
 double Properties::getMicroroughness()
+{
+    if ( !m_lattice->hasSymmetricNeighbours() )
+        return mf_scanMicroroughness();
+
+    return 1. + (double)m_lattice->getSumHeightDifferences()/(2.*m_lattice->getSize()*m_lattice->getSitesPerCell());
+}
+
+double Properties::mf_scanMicroroughness()
 {
     double dRough = 0.0;
     for ( int i = 0; i < m_lattice->getSize(); i++){
@@ -16,10 +24,16 @@ double Properties::getMicroroughness()
             dRough += abs( s->getHeight() - m_lattice->getSite( i )->getHeight() );
     }
 
-    return 1. + dRough/(2.*m_lattice->getSize());
+    return 1. + dRough/(2.*m_lattice->getSize()*m_lattice->getSitesPerCell());
 }
 
 double Properties::getRMS()
+{
+    //The heights of the cells of a coarse-grained lattice are the sums of the heights of their sites
+    return sqrt( (double)m_lattice->getSumSquaredHeights()/(double)m_lattice->getSize() )/m_lattice->getSitesPerCell();
+}
+
+double Properties::mf_scanRMS()
 {
     double sum = 0;
     double mean = 0;
@@ -33,7 +47,7 @@ double Properties::getRMS()
     for (unsigned int i=0; i<m_lattice->getSize(); i++)
         dev += m_lattice->getSite( i )->getHeight()*m_lattice->getSite( i )->getHeight();
 
-    return sqrt( dev/(double)m_lattice->getSize() );
+    return sqrt( dev/(double)m_lattice->getSize() )/m_lattice->getSitesPerCell();
 }
 
 double Properties::eventCountingGrowthRate( int adsorptionCounts, int desortionCounts, double time)
@@ -45,14 +59,24 @@ double Properties::eventCountingGrowthRate( int adsorptionCounts, int desortionC
 }
 
 double Properties::getMeanDH()
+{
+    //On an FCC lattice only the sites of the film are counted
+    if ( m_lattice->getType() == Lattice::SimpleCubic || m_lattice->getType() == Lattice::CoarseGrained )
+        return (double)m_lattice->getSumHeights()/( (double)m_lattice->getSize()*m_lattice->getSitesPerCell() );
+
+    return mf_scanMeanDH();
+}
+
+double Properties::mf_scanMeanDH()
 {
     double mean = 0.0, sum = 0.0 ;
     if ( m_lattice->getType() == Lattice::FCC ){
         int iCount = 0;
+        int iCu = m_parameters->getSpeciesRegistry().getID( "Cu" );
         for (unsigned int i=0; i< m_lattice->getSize(); i++){
             //This is not correct. It should just counts the height. What it is there should be seen by the individual processes.
-            if ( m_lattice->getSite( i )->getLabel() == "Cu"){
-                if ( m_lattice->getSite(i)->getHeight() > m_lattice->getSite(i)->get1stNeihbors()[ -1 ][ 0 ]->getHeight() ){
+            if ( m_lattice->getSite( i )->getSpecies() == iCu ){
+                if ( m_lattice->getSite(i)->getHeight() > m_lattice->getSite(i)->get1stNeihbors( -1 )[ 0 ]->getHeight() ){
                     sum += m_lattice->getSite( i )->getHeight();
                     iCount++;
                 }
@@ -61,14 +85,20 @@ double Properties::getMeanDH()
 
         mean = sum/iCount;
     }
-    else if ( m_lattice->getType() == Lattice::SimpleCubic ){
+    else if ( m_lattice->getType() == Lattice::SimpleCubic || m_lattice->getType() == Lattice::CoarseGrained ){
         for (unsigned int i=0; i< m_lattice->getSize(); i++)
             sum += (double)m_lattice->getSite( i )->getHeight();
 
-        mean = sum/(double)m_lattice->getSize();
+        mean = sum/( (double)m_lattice->getSize()*m_lattice->getSitesPerCell() );
     }
 
     return mean;
 }
 
+void Properties::checkSurfaceSums()
+{
+    if ( getMeanDH() != mf_scanMeanDH() || getRMS() != mf_scanRMS() || getMicroroughness() != mf_scanMicroroughness() )
+        m_errorHandler->warningSimple_msg( "The surface statistics kept by the lattice differ from the ones of its sites." );
+}
+
 }
@@ -41,7 +41,15 @@ public:
     double classCoverage();
     double getMeanDH();
 
+    /// Compares the surface statistics kept by the lattice with the ones computed from all its sites and warns if they differ (debug mode).
+    void checkSurfaceSums();
+
 private:
+    /// The surface statistics computed from all the sites of the lattice
+    double mf_scanMicroroughness();
+    double mf_scanRMS();
+    double mf_scanMeanDH();
+
     //The roughness of the surface
     double m_dRoughness;
 
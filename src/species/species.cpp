@@ -35,18 +35,18 @@ m_id(id)
 Species::~Species(){}
 
 // Returns name of the species
-string Species::getName()
+const string& Species::getName() const
 {
     return m_name;
 }
 
 // Returns molecular weight of species
-double Species::getMW()
+double Species::getMW() const
 {
     return m_mw;
 }
 
-const int Species::getId()
+int Species::getId() const
 {
     return m_id;
 }
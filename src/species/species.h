@@ -22,7 +22,7 @@
 
 using namespace std;
 
-/** The basic class of the kinetic monte carlo code. */
+/** A chemical species i.e. its name, molecular weight and its ID in the species registry. */
 
 class Species
 {
@@ -34,13 +34,13 @@ public:
 
     virtual ~Species();
 
-    string getName();
-    
-    double getMW();
+    const string& getName() const;
+
+    double getMW() const;
 
     double getStoicCoeff();
 
-    const int getId();
+    int getId() const;
 
 protected:
 
@@ -0,0 +1,44 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "species_registry.h"
+
+SpeciesRegistry::SpeciesRegistry(){ add( "" ); }
+
+SpeciesRegistry::~SpeciesRegistry(){}
+
+int SpeciesRegistry::add( const string& name, double mw )
+{
+    unordered_map<string, int>::const_iterator it = m_mIDs.find( name );
+    if ( it != m_mIDs.end() )
+        return it->second;
+
+    int id = m_vSpecies.size();
+    m_vSpecies.push_back( Species( name, mw, id ) );
+    m_mIDs[ name ] = id;
+
+    return id;
+}
+
+int SpeciesRegistry::getID( const string& name ) const
+{
+    unordered_map<string, int>::const_iterator it = m_mIDs.find( name );
+    if ( it != m_mIDs.end() )
+        return it->second;
+
+    return -1;
+}
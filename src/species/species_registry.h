@@ -0,0 +1,64 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef SPECIES_REGISTRY_H
+#define SPECIES_REGISTRY_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "species.h"
+
+using namespace std;
+
+/** The species of an instance of apothesis with their dense integer IDs (0, 1, 2, ...).
+ * Every species (of the lattice, of the processes, of the growth and of the reports) is registered when the input file
+ * is read and the processes are created. During the run the sites and the processes refer to the species only by their IDs,
+ * so comparing species is comparing integers and the names are used only for reading and writing.
+ * The ID 0 is the empty species i.e. a site without label. */
+class SpeciesRegistry
+{
+public:
+    SpeciesRegistry();
+    virtual ~SpeciesRegistry();
+
+    /// Registers the species (if it is not registered) and returns its ID.
+    /// Registering is not thread safe so the species must be registered before a parallel run starts.
+    int add( const string& name, double mw = 0.0 );
+
+    /// Returns the ID of the species (-1 if it is not registered).
+    int getID( const string& name ) const;
+
+    /// Returns the name of the species with the given ID.
+    inline const string& getName( int id ) const { return m_vSpecies[ id ].getName(); }
+
+    /// Returns the species with the given ID.
+    inline const Species& getSpecies( int id ) const { return m_vSpecies[ id ]; }
+
+    /// Returns the number of species registered.
+    inline int size() const { return m_vSpecies.size(); }
+
+private:
+    /// The species ordered by their ID
+    vector<Species> m_vSpecies;
+
+    /// The ID of each species by its name
+    unordered_map<string, int> m_mIDs;
+};
+
+#endif // SPECIES_REGISTRY_H
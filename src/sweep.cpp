@@ -0,0 +1,146 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#include "sweep.h"
+#include "apothesis.h"
+#include "errorhandler.h"
+
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <algorithm>
+
+Sweep::Sweep( int argc, char* argv[], Apothesis* base, vector<Utils::SweptParameter> parameters, int threads ):
+    m_iArgc( argc ),
+    m_vcArgv( argv ),
+    m_pBase( base ),
+    m_vParameters( parameters ),
+    m_iThreads( threads ),
+    m_iPoints( 1 ),
+    m_iNext( 0 )
+{
+    if ( m_iThreads <= 0 )
+        m_iThreads = max( 1u, thread::hardware_concurrency() );
+
+    for ( const Utils::SweptParameter& parameter:m_vParameters )
+        m_iPoints *= parameter.vsValues.size();
+}
+
+Sweep::~Sweep(){}
+
+int Sweep::exec()
+{
+    m_vsErrors.assign( m_iPoints, "" );
+
+    //Every thread performs the next point that has not been started until all of them are started
+    m_iNext = 0;
+    vector<thread> vThreads;
+    for ( int i = 0; i < min( m_iThreads, m_iPoints ); i++ )
+        vThreads.push_back( thread( [ this ](){
+            for ( int point = m_iNext++; point < m_iPoints; point = m_iNext++ )
+                mf_run( point );
+        } ) );
+
+    for ( thread& t:vThreads )
+        t.join();
+
+    int iFailed = 0;
+    for ( int point = 0; point < m_iPoints; point++ ){
+        if ( !m_vsErrors[ point ].empty() ){
+            cout << "Point " << point << " failed: " << m_vsErrors[ point ] << endl;
+            iFailed++;
+        }
+    }
+
+    mf_write( "Sweep.log" );
+
+    return iFailed;
+}
+
+vector<int> Sweep::mf_values( int point )
+{
+    vector<int> vValues( m_vParameters.size() );
+    for ( int i = m_vParameters.size() - 1; i >= 0; i-- ){
+        vValues[ i ] = point%m_vParameters[ i ].vsValues.size();
+        point /= m_vParameters[ i ].vsValues.size();
+    }
+
+    return vValues;
+}
+
+void Sweep::mf_run( int point )
+{
+    Apothesis* apothesis = 0;
+
+    try {
+        apothesis = new Apothesis( m_iArgc, m_vcArgv, "sweep_" + to_string( point ) );
+        apothesis->readInput();
+
+        //The values of this point replace the values of the input file
+        vector<int> vValues = mf_values( point );
+        for ( unsigned int i = 0; i < m_vParameters.size(); i++ ){
+            const Utils::SweptParameter& parameter = m_vParameters[ i ];
+            string value = parameter.vsValues[ vValues[ i ] ];
+
+            if ( parameter.sName.compare("temperature") == 0 )
+                apothesis->pParameters->setTemperature( stod( value ) );
+            else if ( parameter.sName.compare("pressure") == 0 )
+                apothesis->pParameters->setPressure( stod( value ) );
+            else {
+                vector<string> vsParams = apothesis->pParameters->getProcessesInfo()[ parameter.sName ];
+                vsParams[ parameter.iPosition ] = value;
+                apothesis->pParameters->setProcess( parameter.sName, vsParams );
+            }
+        }
+
+        apothesis->build( m_pBase );
+        apothesis->init();
+        apothesis->exec();
+    }
+    catch ( const ApothesisError& error ){
+        string sError = apothesis ? apothesis->pErrorHandler->getLastError() : "";
+        m_vsErrors[ point ] = sError.empty() ? error.what() : sError;
+    }
+
+    delete apothesis;
+}
+
+void Sweep::mf_write( string file )
+{
+    ofstream out( file );
+    out << "Sweep of " << m_iPoints << " points" << endl;
+    out << endl;
+
+    out << "Point" << '\t' << "Directory" << '\t';
+    for ( const Utils::SweptParameter& parameter:m_vParameters ){
+        if ( parameter.iPosition == 0 )
+            out << parameter.sName << '\t';
+        else
+            out << parameter.sName << " (" << parameter.iPosition << ")" << '\t';
+    }
+    out << "Status" << endl;
+
+    for ( int point = 0; point < m_iPoints; point++ ){
+        out << point << '\t' << "sweep_" + to_string( point ) << '\t';
+
+        vector<int> vValues = mf_values( point );
+        for ( unsigned int i = 0; i < m_vParameters.size(); i++ )
+            out << m_vParameters[ i ].vsValues[ vValues[ i ] ] << '\t';
+
+        out << ( m_vsErrors[ point ].empty() ? "finished" : "failed: " + m_vsErrors[ point ] ) << endl;
+    }
+}
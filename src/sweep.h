@@ -0,0 +1,86 @@
+//============================================================================
+//    Apothesis: A kinetic Monte Calro (KMC) code for deposition processes.
+//    Copyright (C) 2019  Nikolaos (Nikos) Cheimarios
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//============================================================================
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+
+#include "parameters.h"
+
+using namespace std;
+
+class Apothesis;
+
+/** A sweep over the values of temperature, pressure and parameters of the processes (all their combinations).
+ * The lattice and the partition of its sites are built once in a base instance. Every point of the sweep is a separate
+ * (self-contained) Apothesis instance which copies them, creates its processes with its own parameters (so only the
+ * rate constants change) and writes its own output in its own directory (sweep_<i>). The points are performed
+ * concurrently by a pool of threads and the values of each point are listed in Sweep.log. */
+class Sweep
+{
+public:
+    /// The base must be built (see Apothesis::build) from the same input and it is not changed.
+    /// The points are performed by the given number of threads (0 for the number of cores).
+    Sweep( int argc, char* argv[], Apothesis* base, vector<Utils::SweptParameter> parameters, int threads );
+
+    virtual ~Sweep();
+
+    /// Performs all the points and writes the list of the points. Returns the number of points that failed.
+    int exec();
+
+    /// Returns the number of points.
+    inline int getNumPoints(){ return m_iPoints; }
+
+private:
+    /// Performs one point
+    void mf_run( int point );
+
+    /// Returns the position of the value of each swept parameter for the given point (the last parameter changes first)
+    vector<int> mf_values( int point );
+
+    /// Writes the values of every point
+    void mf_write( string file );
+
+    /// The number of flags given by the user
+    int m_iArgc;
+
+    /// The flags given by the user
+    char** m_vcArgv;
+
+    /// The instance that holds the lattice and the partition which are copied
+    Apothesis* m_pBase;
+
+    /// The swept parameters
+    vector<Utils::SweptParameter> m_vParameters;
+
+    /// The number of threads
+    int m_iThreads;
+
+    /// The number of points
+    int m_iPoints;
+
+    /// The next point to be performed by a thread
+    atomic<int> m_iNext;
+
+    /// The error of each point (empty if it finished)
+    vector<string> m_vsErrors;
+};
+
+#endif // SWEEP_H